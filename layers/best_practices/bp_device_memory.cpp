@@ -144,7 +144,7 @@ bool BestPractices::PreCallValidateFreeMemory(VkDevice device, VkDeviceMemory me
     ASSERT_AND_RETURN_SKIP(mem_info);
 
     for (const auto& item : mem_info->ObjectBindings()) {
-        const auto& obj = item.first;
+        const auto& obj = item.handle;
         const LogObjectList objlist(device, obj, mem_info->Handle());
         skip |= LogWarning("BestPractices", objlist, error_obj.location, "VK Object %s still has a reference to mem obj %s.",
                            FormatHandle(obj).c_str(), FormatHandle(mem_info->Handle()).c_str());
@@ -29,6 +29,7 @@
 #include <cstdint>
 #include "containers/range.h"
 #include "containers/container_utils.h"
+#include "parallel_hashmap/btree.h"
 
 #define RANGE_ASSERT(b) assert(b)
 
@@ -60,6 +61,19 @@ struct split_op_keep_upper {
 
 enum class value_precedence { prefer_source, prefer_dest };
 
+// Whether inserting into or erasing from ImplMap leaves iterators to the other entries valid. Node based maps (std::map) do,
+// B-trees move entries between nodes as they grow and shrink. The generic algorithms below re-seek after changing the map
+// when iterators aren't stable.
+template <typename ImplMap>
+struct impl_map_traits {
+    static constexpr bool stable_iterators = true;
+};
+
+template <typename Key, typename T, typename Compare, typename Alloc>
+struct impl_map_traits<phmap::btree_map<Key, T, Compare, Alloc>> {
+    static constexpr bool stable_iterators = false;
+};
+
 template <typename Iterator, typename Map, typename Range>
 Iterator split(Iterator in, Map &map, const Range &range);
 
@@ -84,6 +98,7 @@ class range_map {
     using key_type = typename ImplMap::key_type;
     using index_type = typename key_type::index_type;
     using size_type = typename ImplMap::size_type;
+    static constexpr bool stable_iterators = impl_map_traits<ImplMap>::stable_iterators;
 
   protected:
     template <typename ThisType>
@@ -283,6 +298,10 @@ class range_map {
         }
         // Return the current position which should be the upper_bound for bounds
         RANGE_ASSERT(pos == upper_bound_impl(bounds));
+        if constexpr (!stable_iterators) {
+            // The inserts above may have moved the entry lower pointed to
+            lower = lower_bound_impl(bounds);
+        }
         return range<ImplIterator>(lower, pos);
     }
 
@@ -442,13 +461,18 @@ class range_map {
     }
 
     iterator erase(range<iterator> bounds) {
-        auto current = bounds.begin.pos_;
-        while (current != bounds.end.pos_) {
-            RANGE_ASSERT(!at_impl_end(current));
-            current = impl_map_.erase(current);
+        if constexpr (!stable_iterators) {
+            // bounds.end may be moved by the first erase, so let the ImplMap handle the whole range
+            return iterator(impl_map_.erase(bounds.begin.pos_, bounds.end.pos_));
+        } else {
+            auto current = bounds.begin.pos_;
+            while (current != bounds.end.pos_) {
+                RANGE_ASSERT(!at_impl_end(current));
+                current = impl_map_.erase(current);
+            }
+            RANGE_ASSERT(current == bounds.end.pos_);
+            return current;
         }
-        RANGE_ASSERT(current == bounds.end.pos_);
-        return current;
     }
 
     iterator erase(iterator first, iterator last) { return erase(range<iterator>(first, last)); }
@@ -633,6 +657,12 @@ class range_map {
     const ImplMap &get_implementation_map() const { return impl_map_; }
 };
 
+// range_map stored in a B-tree. Entries are kept in arrays inside the nodes, which makes lookups and traversal much more
+// cache friendly than std::map, and avoids a heap allocation per range. Inserts and erases may move other entries though,
+// so only iterators returned by the modifying call are valid afterwards.
+template <typename Key, typename T, typename RangeKey = vvl::range<Key>>
+using btree_range_map = range_map<Key, T, RangeKey, phmap::btree_map<RangeKey, T>>;
+
 template <typename Container>
 using const_correct_iterator = decltype(std::declval<Container>().begin());
 
@@ -649,6 +679,8 @@ class small_range_map {
     using key_type = RangeKey;
     using value_type = std::pair<const key_type, mapped_type>;
     using index_type = typename key_type::index_type;
+    // Entries live at a fixed slot (their begin index), so other changes never move them
+    static constexpr bool stable_iterators = true;
 
     using size_type = SmallIndex;
     template <typename Map_, typename Value_>
@@ -1360,7 +1392,14 @@ class cached_lower_bound_impl {
     }
 
     inline iterator lower_bound(const index_type &index) { return map_->lower_bound(key_type(index, index + 1)); }
-    inline bool at_end(const iterator &it) const { return it == end_; }
+    inline bool at_end(const iterator &it) const {
+        if constexpr (plain_map_type::stable_iterators) {
+            return it == end_;
+        } else {
+            // end() can move along with the last entry
+            return it == map_->end();
+        }
+    }
 
     bool is_lower_than(const index_type &index, const iterator &it) { return at_end(it) || (index < it->first.end); }
 
@@ -1446,7 +1485,7 @@ class cached_lower_bound_impl {
     // Allow a hint for a *valid* lower bound for current index
     // TODO: if the fail-over becomes a hot-spot, the hint logic could be far more clever (looking at previous/next...)
     cached_lower_bound_impl &invalidate(const iterator &hint) {
-        if ((hint != end_) && hint->first.includes(index_)) {
+        if (!at_end(hint) && hint->first.includes(index_)) {
             auto index = index_;  // by copy set modifies in place
             set_value(index, hint);
         } else {
@@ -1514,7 +1553,8 @@ Iterator split(Iterator in, Map &map, const Range &range) {
 // Apply an operation over a range map, infilling where content is absent, updating where content is present.
 // The passed pos must *either* be strictly less than range or *is* lower_bound (which may be end)
 // Trims to range boundaries.
-// infill op doesn't have to alter map, but mustn't invalidate iterators passed to it. (i.e. no erasure)
+// infill op doesn't have to alter map, but mustn't erase. For maps with stable iterators it mustn't invalidate the iterator
+// passed to it either, otherwise that iterator is looked up again after the infill.
 // infill data (default mapped value or other initial value) is contained with ops.
 // update allows existing ranges to be updated (merged, whatever) based on data contained in ops.  All iterators
 // passed to update are already trimmed to fit within range.
@@ -1523,42 +1563,51 @@ Iterator infill_update_range(RangeMap &map, Iterator pos, const typename RangeMa
     using KeyType = typename RangeMap::key_type;
     using IndexType = typename RangeMap::index_type;
 
-    const auto end = map.end();
-    assert((pos == end) || (pos == map.lower_bound(range)) || pos->first.strictly_less(range));
+    // Not cached, as for maps without stable iterators end() moves with the inserts below
+    auto at_end = [&map](const Iterator &it) { return it == map.end(); };
+    assert(at_end(pos) || (pos == map.lower_bound(range)) || pos->first.strictly_less(range));
 
     if (range.empty()) return pos;
-    if (pos == end) {
+    if (at_end(pos)) {
         // Only pass pos == end for range tail after last entry
-        assert(end == map.lower_bound(range));
+        assert(map.end() == map.lower_bound(range));
     } else if (pos->first.strictly_less(range)) {
         // pos isn't lower_bound for range (it's less than range), however, if range is monotonically increasing it's likely
-        // the next entry in the map will be the lower bound.
+        // the lower bound is only a few entries further along.
 
-        // If the new (pos + 1) *isn't* stricly_less and pos is,
-        // (pos + 1) must be the lower_bound, otherwise we have to look for it O(log n)
-        ++pos;
-        if ((pos != end) && pos->first.strictly_less(range)) {
+        // Walk forward a little before giving up and looking for it O(log n)
+        constexpr int kWalkLimit = 4;
+        int walked = 0;
+        do {
+            ++pos;
+            ++walked;
+        } while (!at_end(pos) && pos->first.strictly_less(range) && walked < kWalkLimit);
+        if (!at_end(pos) && pos->first.strictly_less(range)) {
             pos = map.lower_bound(range);
         }
         assert(pos == map.lower_bound(range));
     }
 
-    if ((pos != end) && (range.begin > pos->first.begin)) {
+    if (!at_end(pos) && (range.begin > pos->first.begin)) {
         // lower bound starts before the range, trim and advance
         pos = map.split(pos, range.begin, sparse_container::split_op_keep_both());
         ++pos;
     }
 
     IndexType current_begin = range.begin;
-    while ((pos != end) && (current_begin < range.end)) {
+    while (!at_end(pos) && (current_begin < range.end)) {
         // The current_begin is either pointing to the next existing value to update or the beginning of a gap to infill
         assert(pos->first.begin >= current_begin);
 
         if (current_begin < pos->first.begin) {
             // We have a gap to infill (we supply pos for ("insert in front of" calls)
-            ops.infill(map, pos, KeyType(current_begin, std::min(range.end, pos->first.begin)));
-            // Advance current begin, but *not* pos as it's the next valid value. (infill shall not invalidate pos)
-            current_begin = pos->first.begin;
+            const IndexType next_begin = pos->first.begin;
+            ops.infill(map, pos, KeyType(current_begin, std::min(range.end, next_begin)));
+            if constexpr (!RangeMap::stable_iterators) {
+                pos = map.lower_bound(KeyType(next_begin, next_begin + 1));
+            }
+            // Advance current begin, but *not* pos as it's the next valid value.
+            current_begin = next_begin;
         } else {
             // We need to run the update operation on the valid portion of the current value
             if (pos->first.end > range.end) {
@@ -1578,6 +1627,10 @@ Iterator infill_update_range(RangeMap &map, Iterator pos, const typename RangeMa
     // Fill to the end as needed
     if (current_begin < range.end) {
         ops.infill(map, pos, KeyType(current_begin, range.end));
+        if constexpr (!RangeMap::stable_iterators) {
+            // The returned position is the hint for the next range in infill_update_rangegen
+            pos = map.upper_bound(range);
+        }
     }
 
     return pos;
@@ -1590,12 +1643,28 @@ void infill_update_range(RangeMap &map, const typename RangeMap::key_type &range
     infill_update_range(map, pos, range, ops);
 }
 
+// Batched infill_update_range over all the ranges of a strictly monotonic range generator (e.g. the subresource ranges of
+// an image barrier). The map is walked once alongside the generator: each range starts its search from where the previous
+// one finished, and runs of abutting ranges are applied as one range, so they aren't split from each other in the map.
+// This relies on the ops giving the same result for a range as for consecutive pieces of it.
 template <typename RangeMap, typename RangeGen, typename InfillUpdateOps>
 void infill_update_rangegen(RangeMap &map, RangeGen &range_gen, const InfillUpdateOps &ops) {
-    auto pos = map.lower_bound(*range_gen);
-    for (; range_gen->non_empty(); ++range_gen) {
-        pos = infill_update_range(map, pos, *range_gen, ops);
+    using KeyType = typename RangeMap::key_type;
+    if (!range_gen->non_empty()) return;
+
+    KeyType batch = *range_gen;
+    auto pos = map.lower_bound(batch);
+    for (++range_gen; range_gen->non_empty(); ++range_gen) {
+        const KeyType &range = *range_gen;
+        assert(batch.end <= range.begin);
+        if (range.begin == batch.end) {
+            batch.end = range.end;
+        } else {
+            pos = infill_update_range(map, pos, batch, ops);
+            batch = range;
+        }
     }
+    infill_update_range(map, pos, batch, ops);
 }
 
 // Parallel iterator
@@ -1844,9 +1913,10 @@ bool update_range_value(Map &map, const Range &range, MapValue &&value, value_pr
             const auto start = pos->index;
             auto it = pos->lower_bound;
             const auto limit = (it != map.end()) ? std::min(it->first.begin, range.end) : range.end;
-            map.insert(it, std::make_pair(Range(start, limit), value));
-            // We inserted before pos->lower_bound, so pos->lower_bound isn't invalid, but the associated index *is* and seek
-            // will fix this (and move the state to valid)
+            auto inserted = map.insert(it, std::make_pair(Range(start, limit), value));
+            // Depending on the map, the insert may have invalidated pos->lower_bound, so restart from the inserted entry and
+            // let seek move the state past it (and to valid)
+            pos.invalidate(inserted, start);
             pos.seek(limit);
             updated = true;
         }
@@ -1878,21 +1948,20 @@ void consolidate(RangeMap &map) {
     using It = typename RangeMap::iterator;
 
     It current = map.begin();
-    const It map_end = map.end();
 
     // To be included in a merge range there must be no gap in the Key space, and the mapped_type values must match
     auto can_merge = [](const It &last, const It &cur) {
         return cur->first.begin == last->first.end && cur->second == last->second;
     };
 
-    while (current != map_end) {
+    while (current != map.end()) {
         // Establish a trival merge range at the current location, advancing current. Merge range is inclusive of merge_last
         const It merge_first = current;
         It merge_last = current;
         ++current;
 
         // Expand the merge range as much as possible
-        while (current != map_end && can_merge(merge_last, current)) {
+        while (current != map.end() && can_merge(merge_last, current)) {
             merge_last = current;
             ++current;
         }
@@ -1902,9 +1971,10 @@ void consolidate(RangeMap &map) {
             // IFF there is more than one range in (merge_first, merge_last)  <- again noting the *inclusive* last
             // Create a new Val spanning (first, last), substitute it for the multiple entries.
             Value merged_value = std::make_pair(Key(merge_first->first.begin, merge_last->first.end), merge_last->second);
-            // Note that current points to merge_last + 1, and is valid even if at map_end for these operations
-            map.erase(merge_first, current);
-            map.insert(current, std::move(merged_value));
+            // Use the iterators returned by erase and insert, the map may not keep the others valid
+            current = map.erase(merge_first, current);
+            current = map.insert(current, std::move(merged_value));
+            ++current;
         }
     }
 }
@@ -18,13 +18,13 @@
  * John Zulauf <jzulauf@lunarg.com>
  *
  */
+#include <algorithm>
 #include <cassert>
 #include <vulkan/utility/vk_format_utils.h>
 
 #include "subresource_adapter.h"
 #include <cmath>
-#include "state_tracker/image_state.h"
-#include "generated/dispatch_functions.h"
+#include "utils/vk_layer_utils.h"
 
 namespace subresource_adapter {
 Subresource::Subresource(const RangeEncoder& encoder, const VkImageSubresource& subres)
@@ -269,27 +269,14 @@ RangeGenerator& RangeGenerator::operator++() {
     return *this;
 }
 
-ImageRangeEncoder::ImageRangeEncoder(const vvl::Image& image)
-    : ImageRangeEncoder(image, AspectParameters::Get(image.full_range.aspectMask)) {}
+ImageRangeEncoder::ImageRangeEncoder(const VkImageCreateInfo& create_info, const VkImageSubresourceRange& full_range)
+    : ImageRangeEncoder(create_info, full_range, AspectParameters::Get(full_range.aspectMask)) {}
 
-ImageRangeEncoder::ImageRangeEncoder(const vvl::Image& image, const AspectParameters* param)
-    : RangeEncoder(image.full_range, param), total_size_(0U) {
-    if (image.create_info.extent.depth > 1) {
-        limits_.arrayLayer = image.create_info.extent.depth;
-    }
-
-    linear_image_ = false;
-    if (image.create_info.tiling == VK_IMAGE_TILING_LINEAR) {
-        linear_image_ = true;
-
-        // WORKAROUND for profile and mock_icd not containing valid VkSubresourceLayout yet. Treat it as optimal image.
-        const VkImageAspectFlags first_aspect = AspectBit(0);  // AspectBit returns aspects by index
-        VkImageSubresource mock_test_subres = {first_aspect, 0, 0};
-        VkSubresourceLayout mock_test_layout = {};
-        DispatchGetImageSubresourceLayout(image.store_device_as_workaround, image.VkHandle(), &mock_test_subres, &mock_test_layout);
-        if (mock_test_layout.size == 0) {  // Happens only for mock icd
-            linear_image_ = false;
-        }
+ImageRangeEncoder::ImageRangeEncoder(const VkImageCreateInfo& create_info, const VkImageSubresourceRange& full_range,
+                                     const AspectParameters* param)
+    : RangeEncoder(full_range, param), total_size_(0U) {
+    if (create_info.extent.depth > 1) {
+        limits_.arrayLayer = create_info.extent.depth;
     }
 
     // WORKAROUND for not being able to handle general linear images without resulting in non-monotonically increasing ranges
@@ -301,61 +288,39 @@ ImageRangeEncoder::ImageRangeEncoder(const vvl::Image& image, const AspectParame
     //       checking for hazards or updating state.
     //
     // Needs a rework on how linear range generation is done to ensure correct sizing and monotonicity, before detection of
-    // aliased resources can be done correctly.
+    // aliased resources can be done correctly. Until then linear images use the same layout as optimal ones.
     linear_image_ = false;
 
-    is_compressed_ = vkuFormatIsCompressed(image.create_info.format);
-    texel_block_extent_ = vkuFormatTexelBlockExtent(image.create_info.format);
+    is_compressed_ = vkuFormatIsCompressed(create_info.format);
+    texel_block_extent_ = vkuFormatTexelBlockExtent(create_info.format);
 
-    is_3_d_ = image.create_info.imageType == VK_IMAGE_TYPE_3D;
+    is_3_d_ = create_info.imageType == VK_IMAGE_TYPE_3D;
     y_interleave_ = false;
 
     VkSubresourceLayout layout = {};
-    VkImageSubresourceLayers subres_layers = {limits_.aspectMask, 0, 0, limits_.arrayLayer};
 
     for (uint32_t aspect_index = 0; aspect_index < limits_.aspect_index; ++aspect_index) {
-        VkImageSubresource subres = {};
-        subres.aspectMask = static_cast<VkImageAspectFlags>(AspectBit(aspect_index));
-        subres_layers.aspectMask = subres.aspectMask;
-        texel_sizes_.push_back(
-            vkuFormatTexelSizeWithAspect(image.create_info.format, static_cast<VkImageAspectFlagBits>(subres.aspectMask)));
+        const VkImageAspectFlags aspect_mask = static_cast<VkImageAspectFlags>(AspectBit(aspect_index));
+        texel_sizes_.push_back(vkuFormatTexelSizeWithAspect(create_info.format, static_cast<VkImageAspectFlagBits>(aspect_mask)));
         IndexType aspect_size = 0;
         for (uint32_t mip_index = 0; mip_index < limits_.mipLevel; ++mip_index) {
-            subres_layers.mipLevel = mip_index;
-            subres.mipLevel = mip_index;
-            auto subres_extent = image.GetEffectiveSubresourceExtent(subres_layers);
-
-            if (linear_image_) {
-                DispatchGetImageSubresourceLayout(image.store_device_as_workaround, image.VkHandle(), &subres, &layout);
-                if (is_3_d_) {
-                    if ((layout.depthPitch == 0) && (subres_extent.depth == 1)) {
-                        layout.depthPitch = layout.size;  // Certain implmentations don't supply pitches when size is 1
-                    }
-                    y_interleave_ = y_interleave_ || (layout.rowPitch > layout.depthPitch);
-                } else {
-                    if ((layout.arrayPitch == 0) && (limits_.arrayLayer == 1)) {
-                        layout.arrayPitch = layout.size;  // Certain implmentations don't supply pitches when size is 1
-                    }
-                    y_interleave_ = y_interleave_ || (layout.rowPitch > layout.arrayPitch);
-                }
+            const VkExtent3D subres_extent = GetEffectiveExtent(create_info, aspect_mask, mip_index);
+            layout.offset += layout.size;
+
+            const double row_pitch = subres_extent.width * texel_sizes_[aspect_index];
+            // TODO: layout.rowPitch is still computed incorrectly for ASTC_10x10,
+            // but it is less trivial fix comparing to arrayPitch, so will be fixed
+            // later. There is no known rowPitch bugs, which somehow justifies why
+            // rowPitch fix is postponed, and arrayPitch, which affected Angle, was fixed.
+            layout.rowPitch = static_cast<VkDeviceSize>(row_pitch);
+
+            layout.arrayPitch = static_cast<VkDeviceSize>(row_pitch * subres_extent.height);
+            layout.depthPitch = layout.arrayPitch;
+            if (is_3_d_) {
+                layout.size = layout.depthPitch * subres_extent.depth;
             } else {
-                layout.offset += layout.size;
-
-                const double row_pitch = subres_extent.width * texel_sizes_[aspect_index];
-                // TODO: layout.rowPitch is still computed incorrectly for ASTC_10x10,
-                // but it is less trivial fix comparing to arrayPitch, so will be fixed
-                // later. There is no known rowPitch bugs, which somehow justifies why
-                // rowPitch fix is postponed, and arrayPitch, which affected Angle, was fixed.
-                layout.rowPitch = static_cast<VkDeviceSize>(row_pitch);
-
-                layout.arrayPitch = static_cast<VkDeviceSize>(row_pitch * subres_extent.height);
-                layout.depthPitch = layout.arrayPitch;
-                if (is_3_d_) {
-                    layout.size = layout.depthPitch * subres_extent.depth;
-                } else {
-                    // 2D arrays are not affected by MIP level extent reductions.
-                    layout.size = layout.arrayPitch * limits_.arrayLayer;
-                }
+                // 2D arrays are not affected by MIP level extent reductions.
+                layout.size = layout.arrayPitch * limits_.arrayLayer;
             }
             subres_info_.emplace_back(layout, subres_extent, texel_block_extent_, texel_sizes_[aspect_index]);
             aspect_size += layout.size;
@@ -363,7 +328,7 @@ ImageRangeEncoder::ImageRangeEncoder(const vvl::Image& image, const AspectParame
         }
         aspect_sizes_.emplace_back(aspect_size);
         aspect_extent_divisors_.emplace_back(
-            vkuFindMultiplaneExtentDivisors(image.create_info.format, static_cast<VkImageAspectFlagBits>(subres.aspectMask)));
+            vkuFindMultiplaneExtentDivisors(create_info.format, static_cast<VkImageAspectFlagBits>(aspect_mask)));
     }
 }
 
@@ -722,6 +687,7 @@ ImageRangeGenerator& ImageRangeGenerator::operator++() {
         if (incr_state_.layer_z_index < incr_state_.layer_z_count) {
             incr_state_.layer_z_base += incr_state_.incr_layer_z;
             incr_state_.y_base = incr_state_.layer_z_base;
+            incr_state_.y_index = 0;
             pos_ = incr_state_.y_base;
         } else {
             // For aspects and mips we need to move to a new subresource layer info
@@ -753,6 +719,34 @@ ImageRangeGenerator& ImageRangeGenerator::operator++() {
     return *this;
 }
 
+uint32_t ImageRangeGenerator::Fill(IndexRange* ranges, uint32_t max_count) {
+    uint32_t count = 0;
+    while (count < max_count && pos_.non_empty()) {
+        // The remaining rows of the current layer (or depth slice) are evenly spaced, so write them without going through
+        // the incrementer, then let operator++ handle the move to the next layer, mip or aspect.
+        uint32_t batch = 1;
+        if (!single_full_size_range_) {
+            const uint32_t rows_left = (incr_state_.y_count - incr_state_.y_index + incr_state_.y_step - 1) / incr_state_.y_step;
+            batch = std::max(1u, std::min(rows_left, max_count - count));
+        }
+        const IndexRange first = pos_;
+        const IndexType incr_y = incr_state_.incr_y;
+        IndexRange* out = ranges + count;
+        for (uint32_t i = 0; i < batch; ++i) {
+            out[i] = first + i * incr_y;
+        }
+        count += batch;
+
+        if (batch > 1) {
+            incr_state_.y_index += (batch - 1) * incr_state_.y_step;
+            incr_state_.y_base += (batch - 1) * incr_y;
+            pos_ = incr_state_.y_base;
+        }
+        ++(*this);
+    }
+    return count;
+}
+
 template <typename AspectTraits>
 class AspectParametersImpl : public AspectParameters {
   public:
@@ -878,7 +872,22 @@ ImageRangeEncoder::SubresInfo::SubresInfo(const SubresInfo&rhs)
       layer_span(rhs.layer_span) {}
 
 void ImageRangeGenerator::IncrementerState::Set(uint32_t y_count_, uint32_t layer_z_count_, IndexType base, IndexType span,
-                                                IndexType y_step, IndexType z_step) {
+                                                IndexType y_pitch, IndexType z_pitch) {
+    // Closed form for contiguous layouts: rows that abut are a single range, and once a layer (or depth slice) is a single
+    // range, abutting layers are too. Consumers treat consecutive pieces of a range the same as the whole range.
+    const uint32_t row_count = (y_count_ + y_step - 1) / y_step;
+    if (row_count > 1 && span == y_pitch) {
+        span *= row_count;
+        y_count_ = 1;
+    }
+    if (y_count_ <= y_step) {
+        const uint32_t layer_z_steps = (layer_z_count_ + layer_z_step - 1) / layer_z_step;
+        if (layer_z_steps > 1 && span == z_pitch) {
+            span *= layer_z_steps;
+            layer_z_count_ = 1;
+        }
+    }
+
     y_count = y_count_;
     layer_z_count = layer_z_count_;
     y_index = 0;
@@ -886,8 +895,8 @@ void ImageRangeGenerator::IncrementerState::Set(uint32_t y_count_, uint32_t laye
     y_base.begin = base;
     y_base.end = base + span;
     layer_z_base = y_base;
-    incr_y = y_step;
-    incr_layer_z = z_step;
+    incr_y = y_pitch;
+    incr_layer_z = z_pitch;
 }
 
 }  // namespace subresource_adapter
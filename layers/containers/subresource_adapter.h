@@ -28,10 +28,6 @@
 #include "containers/small_vector.h"
 #include "vulkan/vulkan.h"
 
-namespace vvl {
-class Image;
-}  // namespace vvl
-
 namespace subresource_adapter {
 
 class RangeEncoder;
@@ -359,8 +355,9 @@ class ImageRangeEncoder : public RangeEncoder {
     // The default constructor for default iterators
     ImageRangeEncoder() {}
 
-    ImageRangeEncoder(const vvl::Image& image, const AspectParameters* param);
-    explicit ImageRangeEncoder(const vvl::Image& image);
+    ImageRangeEncoder(const VkImageCreateInfo& create_info, const VkImageSubresourceRange& full_range,
+                      const AspectParameters* param);
+    ImageRangeEncoder(const VkImageCreateInfo& create_info, const VkImageSubresourceRange& full_range);
     ImageRangeEncoder(const ImageRangeEncoder& from) = default;
 
     inline IndexType Encode2D(const VkSubresourceLayout& layout, uint32_t layer, uint32_t aspect_index,
@@ -421,6 +418,10 @@ class ImageRangeGenerator {
     ImageRangeGenerator& operator++();
     ImageRangeGenerator& operator=(const ImageRangeGenerator&) = default;
 
+    // Writes up to max_count of the next ranges to ranges and advances past them. Returns the number of ranges written,
+    // less than max_count only when the generator reached its end.
+    uint32_t Fill(IndexRange* ranges, uint32_t max_count);
+
   private:
     bool Convert2DCompatibleTo3D();
     void SetUpSubresInfo();
@@ -462,7 +463,7 @@ class ImageRangeGenerator {
         IndexRange layer_z_base = {0U, 0U};
         IndexType incr_y = 0U;
         IndexType incr_layer_z = 0U;
-        void Set(uint32_t y_count_, uint32_t layer_z_count_, IndexType base, IndexType span, IndexType y_step, IndexType z_step);
+        void Set(uint32_t y_count_, uint32_t layer_z_count_, IndexType base, IndexType span, IndexType y_pitch, IndexType z_pitch);
     };
     IncrementerState incr_state_;
     bool single_full_size_range_ = true;
@@ -478,7 +479,7 @@ class BothRangeMap {
     using SmallMapIterator = typename SmallMap::iterator;
     using SmallMapConstIterator = typename SmallMap::const_iterator;
 
-    using BigMap = sparse_container::range_map<IndexType, T>;
+    using BigMap = sparse_container::btree_range_map<IndexType, T>;
     using BigMapIterator = typename BigMap::iterator;
     using BigMapConstIterator = typename BigMap::const_iterator;
 
@@ -487,6 +488,7 @@ class BothRangeMap {
     using key_type = vvl::range<IndexType>;
     using mapped_type = T;
     using value_type = std::pair<const key_type, mapped_type>;
+    static constexpr bool stable_iterators = SmallMap::stable_iterators && BigMap::stable_iterators;
 
     template <typename Value, typename SmallIt, typename BigIt>
     class IteratorImpl {
@@ -615,13 +617,13 @@ class BothRangeMap {
     }
 
     // TODO -- this is supposed to be a const_iterator, which is constructable from an iterator
-    void insert(const iterator& hint, const value_type& value) {
+    iterator insert(const iterator& hint, const value_type& value) {
         if (UsesSmallMap()) {
             assert(hint.is_small_it_);
-            GetSmallMap().insert(hint.small_it_, value);
+            return iterator(GetSmallMap().insert(hint.small_it_, value));
         } else {
             assert(!hint.is_small_it_);
-            GetBigMap().insert(hint.big_it_, value);
+            return iterator(GetBigMap().insert(hint.big_it_, value));
         }
     }
 
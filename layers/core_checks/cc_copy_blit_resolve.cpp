@@ -17,6 +17,8 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <array>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -117,6 +119,12 @@ static bool RegionIntersects(const RegionType *region0, const RegionType *region
     return GetRegionIntersection(region0, region1, type, is_multiplane).has_instersection;
 }
 
+// Blit offsets can be in either order along each axis (mirrored blits)
+static bool BlitRangesIntersect(int32_t a0, int32_t a1, int32_t b0, int32_t b1) {
+    return RangesIntersect(std::min(a0, a1), static_cast<uint64_t>(std::abs(int64_t(a1) - a0)), std::min(b0, b1),
+                           static_cast<uint64_t>(std::abs(int64_t(b1) - b0)));
+}
+
 template <typename RegionType>
 static bool RegionIntersectsBlit(const RegionType *region0, const RegionType *region1, VkImageType type, bool is_multiplane) {
     bool result = false;
@@ -132,16 +140,16 @@ static bool RegionIntersectsBlit(const RegionType *region0, const RegionType *re
         result = true;
         switch (type) {
             case VK_IMAGE_TYPE_3D:
-                result &= RangesIntersect(region0->srcOffsets[0].z, region0->srcOffsets[1].z - region0->srcOffsets[0].z,
-                                          region1->dstOffsets[0].z, region1->dstOffsets[1].z - region1->dstOffsets[0].z);
+                result &= BlitRangesIntersect(region0->srcOffsets[0].z, region0->srcOffsets[1].z, region1->dstOffsets[0].z,
+                                              region1->dstOffsets[1].z);
                 [[fallthrough]];
             case VK_IMAGE_TYPE_2D:
-                result &= RangesIntersect(region0->srcOffsets[0].y, region0->srcOffsets[1].y - region0->srcOffsets[0].y,
-                                          region1->dstOffsets[0].y, region1->dstOffsets[1].y - region1->dstOffsets[0].y);
+                result &= BlitRangesIntersect(region0->srcOffsets[0].y, region0->srcOffsets[1].y, region1->dstOffsets[0].y,
+                                              region1->dstOffsets[1].y);
                 [[fallthrough]];
             case VK_IMAGE_TYPE_1D:
-                result &= RangesIntersect(region0->srcOffsets[0].x, region0->srcOffsets[1].x - region0->srcOffsets[0].x,
-                                          region1->dstOffsets[0].x, region1->dstOffsets[1].x - region1->dstOffsets[0].x);
+                result &= BlitRangesIntersect(region0->srcOffsets[0].x, region0->srcOffsets[1].x, region1->dstOffsets[0].x,
+                                              region1->dstOffsets[1].x);
                 break;
             default:
                 // Unrecognized or new IMAGE_TYPE enums will be caught in parameter_validation
@@ -151,6 +159,138 @@ static bool RegionIntersectsBlit(const RegionType *region0, const RegionType *re
     return result;
 }
 
+// Area of a copy or blit region within one mip level, as half-open ranges along x, y and array layers (z for 3D images).
+// It may be larger than what GetRegionIntersection or RegionIntersectsBlit compare, but never smaller, so regions whose
+// boxes are disjoint can not overlap.
+struct RegionBox {
+    uint32_t region;
+    bool is_src;
+    uint32_t mip_level;
+    std::array<int64_t, 3> begin;
+    std::array<int64_t, 3> end;
+
+    bool Empty() const { return !(begin[0] < end[0] && begin[1] < end[1] && begin[2] < end[2]); }
+    bool Intersects(const RegionBox &other) const {
+        for (uint32_t axis = 0; axis < 3; axis++) {
+            if (!(begin[axis] < other.end[axis] && other.begin[axis] < end[axis])) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// corner0 and corner1 are opposite corners of the area, in any order (blits can be mirrored)
+static RegionBox MakeRegionBox(uint32_t region, bool is_src, const VkImageSubresourceLayers &subresource, VkImageType type,
+                               const std::array<int64_t, 3> &corner0, const std::array<int64_t, 3> &corner1) {
+    RegionBox box = {region, is_src, subresource.mipLevel, {}, {}};
+    for (uint32_t axis = 0; axis < 3; axis++) {
+        box.begin[axis] = std::min(corner0[axis], corner1[axis]);
+        box.end[axis] = std::max(corner0[axis], corner1[axis]);
+    }
+    if (type == VK_IMAGE_TYPE_1D) {
+        box.begin[1] = 0;
+        box.end[1] = 1;
+    }
+    if (type != VK_IMAGE_TYPE_3D) {
+        box.begin[2] = subresource.baseArrayLayer;
+        box.end[2] = int64_t(subresource.baseArrayLayer) + subresource.layerCount;
+    }
+    return box;
+}
+
+static std::array<int64_t, 3> RegionBoxCorner(const VkOffset3D &offset, const VkExtent3D &extent = {0, 0, 0}) {
+    return {int64_t(offset.x) + extent.width, int64_t(offset.y) + extent.height, int64_t(offset.z) + extent.depth};
+}
+
+// Returns the (i, j) pairs, ordered by i then j, for which the source area of region i overlaps the destination area of
+// region j, calling overlaps(i, j) only for regions whose boxes intersect (copies into texture atlases use thousands of
+// regions).
+//
+// Boxes are first split by mip level, then repeatedly into groups that do not touch along x, y or layers, until no axis
+// separates a group any further. Tiled and stacked layouts end up as groups of a few boxes. Only the source and destination
+// boxes of a group that can not be split are compared, with a sweep along x.
+template <typename Overlaps>
+static std::vector<std::pair<uint32_t, uint32_t>> GetRegionOverlaps(std::vector<RegionBox> &boxes, const Overlaps &overlaps) {
+    boxes.erase(std::remove_if(boxes.begin(), boxes.end(), [](const RegionBox &box) { return box.Empty(); }), boxes.end());
+    std::sort(boxes.begin(), boxes.end(), [](const RegionBox &a, const RegionBox &b) { return a.mip_level < b.mip_level; });
+
+    // Groups of boxes that may still contain an overlap, as [begin, end) index ranges into boxes
+    std::vector<std::pair<size_t, size_t>> groups;
+    auto add_group = [&boxes, &groups](size_t begin, size_t end) {
+        bool has_src = false;
+        bool has_dst = false;
+        for (size_t i = begin; i < end; i++) {
+            (boxes[i].is_src ? has_src : has_dst) = true;
+        }
+        if (has_src && has_dst) {
+            groups.emplace_back(begin, end);
+        }
+    };
+    for (size_t begin = 0; begin < boxes.size();) {
+        size_t end = begin + 1;
+        while (end < boxes.size() && boxes[end].mip_level == boxes[begin].mip_level) {
+            end++;
+        }
+        add_group(begin, end);
+        begin = end;
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> found;
+    std::vector<const RegionBox *> open_src;
+    std::vector<const RegionBox *> open_dst;
+    while (!groups.empty()) {
+        const auto [begin, end] = groups.back();
+        groups.pop_back();
+
+        bool split = false;
+        for (uint32_t axis = 0; axis < 3 && !split; axis++) {
+            std::sort(boxes.begin() + begin, boxes.begin() + end,
+                      [axis](const RegionBox &a, const RegionBox &b) { return a.begin[axis] < b.begin[axis]; });
+            size_t part_begin = begin;
+            int64_t part_end = boxes[begin].end[axis];
+            for (size_t i = begin + 1; i < end; i++) {
+                if (boxes[i].begin[axis] >= part_end) {
+                    add_group(part_begin, i);
+                    part_begin = i;
+                    split = true;
+                }
+                part_end = std::max(part_end, boxes[i].end[axis]);
+            }
+            if (split) {
+                add_group(part_begin, end);
+            }
+        }
+        if (split) {
+            continue;
+        }
+
+        // Sorted along z by the last split attempt, sort along x again for the sweep
+        std::sort(boxes.begin() + begin, boxes.begin() + end,
+                  [](const RegionBox &a, const RegionBox &b) { return a.begin[0] < b.begin[0]; });
+        open_src.clear();
+        open_dst.clear();
+        for (size_t i = begin; i < end; i++) {
+            const RegionBox &box = boxes[i];
+            // Boxes that end before this one begins can not intersect anything that comes after it either
+            auto &open_other = box.is_src ? open_dst : open_src;
+            open_other.erase(std::remove_if(open_other.begin(), open_other.end(),
+                                            [&box](const RegionBox *open) { return open->end[0] <= box.begin[0]; }),
+                             open_other.end());
+            for (const RegionBox *open : open_other) {
+                const uint32_t src_region = box.is_src ? box.region : open->region;
+                const uint32_t dst_region = box.is_src ? open->region : box.region;
+                if (box.Intersects(*open) && overlaps(src_region, dst_region)) {
+                    found.emplace_back(src_region, dst_region);
+                }
+            }
+            (box.is_src ? open_src : open_dst).emplace_back(&box);
+        }
+    }
+    std::sort(found.begin(), found.end());
+    return found;
+}
+
 // Test if the extent argument has all dimensions set to 0.
 static inline bool IsExtentAllZeroes(const VkExtent3D &extent) {
     return ((extent.width == 0) && (extent.height == 0) && (extent.depth == 0));
@@ -753,24 +893,18 @@ bool CoreChecks::ValidateCmdCopyBufferBounds(VkCommandBuffer cb, const vvl::Buff
 
         // The union of the source regions, and the union of the destination regions, must not overlap in memory
         if (validate_no_memory_overlaps) {
-            // Sort copy ranges
-            {
-                MemoryRange src_buffer_memory_range(src_binding->memory_offset + region.srcOffset,
-                                                    src_binding->memory_offset + region.srcOffset + region.size);
-                auto insert_pos = std::lower_bound(src_memory_ranges.begin(), src_memory_ranges.end(), src_buffer_memory_range);
-                src_memory_ranges.insert(insert_pos, src_buffer_memory_range);
-            }
-
-            {
-                MemoryRange dst_buffer_memory_range(dst_binding->memory_offset + region.dstOffset,
-                                                    dst_binding->memory_offset + region.dstOffset + region.size);
-                auto insert_pos = std::lower_bound(dst_memory_ranges.begin(), dst_memory_ranges.end(), dst_buffer_memory_range);
-                dst_memory_ranges.insert(insert_pos, dst_buffer_memory_range);
-            }
+            src_memory_ranges.emplace_back(src_binding->memory_offset + region.srcOffset,
+                                           src_binding->memory_offset + region.srcOffset + region.size);
+            dst_memory_ranges.emplace_back(dst_binding->memory_offset + region.dstOffset,
+                                           dst_binding->memory_offset + region.dstOffset + region.size);
         }
     }
 
     if (validate_no_memory_overlaps) {
+        // Sorting once keeps copies with thousands of regions from shifting the vectors on every sorted insertion
+        std::sort(src_memory_ranges.begin(), src_memory_ranges.end());
+        std::sort(dst_memory_ranges.begin(), dst_memory_ranges.end());
+
         // Memory ranges are sorted, so looking for overlaps can be done in linear time
         auto src_ranges_it = src_memory_ranges.cbegin();
         auto dst_ranges_it = dst_memory_ranges.cbegin();
@@ -1768,24 +1902,6 @@ bool CoreChecks::ValidateCmdCopyImage(VkCommandBuffer commandBuffer, VkImage src
             }
         }
 
-        // The union of all source regions, and the union of all destination regions, specified by the elements of regions,
-        // must not overlap in memory
-        // Validation is only performed when source image is the same as destination image.
-        // In the general case, the mapping between an image and its underlying memory is undefined,
-        // so checking for memory overlaps is not possible.
-        if (srcImage == dstImage) {
-            for (uint32_t j = 0; j < regionCount; j++) {
-                if (auto intersection = GetRegionIntersection(region, pRegions[j], src_image_type, is_src_multiplane);
-                    intersection.has_instersection) {
-                    vuid = is_2 ? "VUID-VkCopyImageInfo2-pRegions-00124" : "VUID-vkCmdCopyImage-pRegions-00124";
-                    skip |= LogError(vuid, all_objlist, loc,
-                                     "pRegion[%" PRIu32 "] copy source overlaps with pRegions[%" PRIu32
-                                     "] copy destination. Overlap info, with respect to image (%s):%s",
-                                     i, j, FormatHandle(srcImage).c_str(), intersection.String().c_str());
-                }
-            }
-        }
-
         // track aspect mask in loop through regions
         if ((src_aspect & VK_IMAGE_ASPECT_STENCIL_BIT) != 0) {
             has_stencil_aspect = true;
@@ -1832,6 +1948,35 @@ bool CoreChecks::ValidateCmdCopyImage(VkCommandBuffer commandBuffer, VkImage src
         }
     }
 
+    // The union of all source regions, and the union of all destination regions, specified by the elements of regions,
+    // must not overlap in memory
+    // Validation is only performed when source image is the same as destination image.
+    // In the general case, the mapping between an image and its underlying memory is undefined,
+    // so checking for memory overlaps is not possible.
+    if (srcImage == dstImage && regionCount > 0) {
+        std::vector<RegionBox> boxes;
+        boxes.reserve(2 * regionCount);
+        for (uint32_t i = 0; i < regionCount; i++) {
+            const RegionType &region = pRegions[i];
+            boxes.emplace_back(MakeRegionBox(i, true, region.srcSubresource, src_image_type, RegionBoxCorner(region.srcOffset),
+                                             RegionBoxCorner(region.srcOffset, region.extent)));
+            boxes.emplace_back(MakeRegionBox(i, false, region.dstSubresource, src_image_type, RegionBoxCorner(region.dstOffset),
+                                             RegionBoxCorner(region.dstOffset, region.extent)));
+        }
+        const bool is_src_multiplane = vkuFormatIsMultiplane(src_format);
+        auto overlaps = [&](uint32_t i, uint32_t j) {
+            return GetRegionIntersection(pRegions[i], pRegions[j], src_image_type, is_src_multiplane).has_instersection;
+        };
+        for (const auto &[i, j] : GetRegionOverlaps(boxes, overlaps)) {
+            const auto intersection = GetRegionIntersection(pRegions[i], pRegions[j], src_image_type, is_src_multiplane);
+            vuid = is_2 ? "VUID-VkCopyImageInfo2-pRegions-00124" : "VUID-vkCmdCopyImage-pRegions-00124";
+            skip |= LogError(vuid, all_objlist, loc,
+                             "pRegion[%" PRIu32 "] copy source overlaps with pRegions[%" PRIu32
+                             "] copy destination. Overlap info, with respect to image (%s):%s",
+                             i, j, FormatHandle(srcImage).c_str(), intersection.String().c_str());
+        }
+    }
+
     if (vkuFormatIsCompressed(src_format) && vkuFormatIsCompressed(dst_format)) {
         const VkExtent3D src_block_extent = vkuFormatTexelBlockExtent(src_format);
         const VkExtent3D dst_block_extent = vkuFormatTexelBlockExtent(dst_format);
@@ -3412,18 +3557,28 @@ bool CoreChecks::ValidateCmdBlitImage(VkCommandBuffer commandBuffer, VkImage src
                 }
             }
         }
+    }
 
-        // The union of all source regions, and the union of all destination regions, specified by the elements of regions,
-        // must not overlap in memory
-        if (srcImage == dstImage) {
-            for (uint32_t j = 0; j < regionCount; j++) {
-                if (RegionIntersectsBlit(&region, &pRegions[j], src_image_state->create_info.imageType,
-                                         vkuFormatIsMultiplane(src_format))) {
-                    vuid = is_2 ? "VUID-VkBlitImageInfo2-pRegions-00217" : "VUID-vkCmdBlitImage-pRegions-00217";
-                    skip |=
-                        LogError(vuid, all_objlist, loc, "pRegion[%" PRIu32 "] src overlaps with pRegions[%" PRIu32 "] dst.", i, j);
-                }
-            }
+    // The union of all source regions, and the union of all destination regions, specified by the elements of regions,
+    // must not overlap in memory
+    if (srcImage == dstImage && regionCount > 0) {
+        const VkImageType src_image_type = src_image_state->create_info.imageType;
+        std::vector<RegionBox> boxes;
+        boxes.reserve(2 * regionCount);
+        for (uint32_t i = 0; i < regionCount; i++) {
+            const RegionType &region = pRegions[i];
+            boxes.emplace_back(MakeRegionBox(i, true, region.srcSubresource, src_image_type, RegionBoxCorner(region.srcOffsets[0]),
+                                             RegionBoxCorner(region.srcOffsets[1])));
+            boxes.emplace_back(MakeRegionBox(i, false, region.dstSubresource, src_image_type, RegionBoxCorner(region.dstOffsets[0]),
+                                             RegionBoxCorner(region.dstOffsets[1])));
+        }
+        const bool is_src_multiplane = vkuFormatIsMultiplane(src_format);
+        auto overlaps = [&](uint32_t i, uint32_t j) {
+            return RegionIntersectsBlit(&pRegions[i], &pRegions[j], src_image_type, is_src_multiplane);
+        };
+        for (const auto &[i, j] : GetRegionOverlaps(boxes, overlaps)) {
+            vuid = is_2 ? "VUID-VkBlitImageInfo2-pRegions-00217" : "VUID-vkCmdBlitImage-pRegions-00217";
+            skip |= LogError(vuid, all_objlist, loc, "pRegion[%" PRIu32 "] src overlaps with pRegions[%" PRIu32 "] dst.", i, j);
         }
     }
     return skip;
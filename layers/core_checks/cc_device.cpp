@@ -19,7 +19,6 @@
  * This file deals with anything related to Phyiscal Devices, Logical Devices, or Device Queues Families, Device Masks, etc
  */
 
-#include <fstream>
 #include <vector>
 
 #if defined(__linux__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__GNU__)
@@ -339,6 +338,7 @@ void CoreChecks::FinishDeviceSetup(const VkDeviceCreateInfo *pCreateInfo, const
     BaseClass::FinishDeviceSetup(pCreateInfo, loc);
 
     AdjustValidatorOptions(extensions, enabled_features, spirv_val_options, &spirv_val_option_hash);
+    spirv_val_context = spvContextCreate(PickSpirvEnv(api_version, IsExtEnabled(extensions.vk_khr_spirv_1_4)));
 
     // Allocate shader validation cache
     if (!disabled[shader_validation_caching] && !disabled[shader_validation] && !core_validation_cache) {
@@ -349,22 +349,8 @@ void CoreChecks::FinishDeviceSetup(const VkDeviceCreateInfo *pCreateInfo, const
 #endif
         validation_cache_path += ".bin";
 
-        std::vector<char> validation_cache_data;
-        std::ifstream read_file(validation_cache_path.c_str(), std::ios::in | std::ios::binary);
-
-        if (read_file) {
-            std::copy(std::istreambuf_iterator<char>(read_file), {}, std::back_inserter(validation_cache_data));
-            read_file.close();
-        } else {
-            LogInfo("WARNING-cache-file-error", device, loc,
-                    "Cannot open shader validation cache at %s for reading (it may not exist yet)", validation_cache_path.c_str());
-        }
-
-        VkValidationCacheCreateInfoEXT cacheCreateInfo = vku::InitStructHelper();
-        cacheCreateInfo.initialDataSize = validation_cache_data.size();
-        cacheCreateInfo.pInitialData = validation_cache_data.data();
-        cacheCreateInfo.flags = 0;
-        CoreLayerCreateValidationCacheEXT(device, &cacheCreateInfo, nullptr, &core_validation_cache);
+        // The cache keeps the file mapped and appends newly validated shaders to it as they come in
+        core_validation_cache = ValidationCache::Open(validation_cache_path, spirv_val_option_hash);
     }
 }
 
@@ -372,41 +358,21 @@ void CoreChecks::PreCallRecordDestroyDevice(VkDevice device, const VkAllocationC
                                             const RecordObject &record_obj) {
     if (!device) return;
 
-    BaseClass::PreCallRecordDestroyDevice(device, pAllocator, record_obj);
-
-    if (core_validation_cache) {
-        Location loc(Func::vkDestroyDevice);
-        size_t validation_cache_size = 0;
-        void *validation_cache_data = nullptr;
-
-        CoreLayerGetValidationCacheDataEXT(device, core_validation_cache, &validation_cache_size, nullptr);
+    // Report anything still pending for modules that were never used, this also has to finish before the cache goes away
+    WaitForAllSpirvValidation();
 
-        validation_cache_data = (char *)malloc(sizeof(char) * validation_cache_size);
-        if (!validation_cache_data) {
-            LogInfo("WARNING-cache-memory-error", device, loc, "Validation Cache Memory Error");
-            return;
-        }
-
-        VkResult result =
-            CoreLayerGetValidationCacheDataEXT(device, core_validation_cache, &validation_cache_size, validation_cache_data);
+    BaseClass::PreCallRecordDestroyDevice(device, pAllocator, record_obj);
 
-        if (result != VK_SUCCESS) {
-            LogInfo("WARNING-cache-retrieval-error", device, loc, "Validation Cache Retrieval Error");
-            free(validation_cache_data);
-            return;
-        }
+    if (spirv_val_context) {
+        spvContextDestroy(spirv_val_context);
+        spirv_val_context = nullptr;
+    }
 
-        if (validation_cache_path.size() > 0) {
-            std::ofstream write_file(validation_cache_path.c_str(), std::ios::out | std::ios::binary);
-            if (write_file) {
-                write_file.write(static_cast<char *>(validation_cache_data), validation_cache_size);
-                write_file.close();
-            } else {
-                LogInfo("WARNING-cache-write-error", device, loc, "Cannot open shader validation cache at %s for writing",
-                        validation_cache_path.c_str());
-            }
+    if (core_validation_cache) {
+        if (!CastFromHandle<ValidationCache *>(core_validation_cache)->Flush()) {
+            LogInfo("WARNING-cache-write-error", device, Location(Func::vkDestroyDevice),
+                    "Cannot open shader validation cache at %s for writing", validation_cache_path.c_str());
         }
-        free(validation_cache_data);
         CoreLayerDestroyValidationCacheEXT(device, core_validation_cache, NULL);
     }
 }
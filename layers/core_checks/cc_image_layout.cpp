@@ -28,6 +28,7 @@
 #include "generated/error_location_helper.h"
 #include "sync/sync_vuid_maps.h"
 #include "utils/image_layout_utils.h"
+#include "state_tracker/device_state.h"
 #include "state_tracker/image_state.h"
 #include "state_tracker/render_pass_state.h"
 #include "state_tracker/cmd_buffer_state.h"
@@ -188,11 +189,21 @@ struct GlobalLayoutUpdater {
 bool CoreChecks::ValidateCmdBufImageLayouts(const Location &loc, const vvl::CommandBuffer &cb_state,
                                             SubmissionImageLayoutMap &submission_image_layout_map) const {
     if (disabled[image_layout_validation]) return false;
-    bool skip = false;
+
+    struct ImageCheck {
+        const vvl::Image *image_state;
+        const image_layout_map::ImageLayoutRegistry *registry;
+        ImageLayoutRangeMap *submission_layout_map;
+        bool first_use;
+    };
+    std::vector<ImageCheck> checks;
+    // Keeps the images alive until the checks are done
+    std::vector<std::shared_ptr<const vvl::Image>> image_states;
+
     // Iterate over the layout maps for each referenced image
     for (const auto &[image, image_layout_registry] : cb_state.image_layout_map) {
         if (!image_layout_registry) continue;
-        const auto image_state = Get<vvl::Image>(image);
+        auto image_state = Get<vvl::Image>(image);
         if (!image_state) continue;
 
         // TODO - things like ANGLE might have external images which have their layouts transitioned implicitly
@@ -205,70 +216,133 @@ bool CoreChecks::ValidateCmdBufImageLayouts(const Location &loc, const vvl::Comm
         // Validate the initial_uses for each subresource referenced
         if (cb_layout_map.empty()) continue;
 
-        const auto subresource_count = image_state->subresource_encoder.SubresourceCount();
-        auto it = submission_image_layout_map.try_emplace(image_state.get(), subresource_count).first;
-        ImageLayoutRangeMap &submission_layout_map = *it->second;
-
         const auto *global_layout_map = image_state->layout_range_map.get();
         ASSERT_AND_CONTINUE(global_layout_map);
-        auto global_layout_map_guard = global_layout_map->ReadLock();
-
-        // Note: don't know if it would matter
-        // if (global_range_map->empty() && overlay_map->empty()) // skip this next loop...;
-
-        auto pos = cb_layout_map.begin();
-        const auto end = cb_layout_map.end();
-        sparse_container::parallel_iterator<const ImageLayoutRangeMap> current_layout(submission_layout_map, *global_layout_map,
-                                                                                      pos->first.begin);
-        while (pos != end) {
-            VkImageLayout initial_layout = pos->second.initial_layout;
-            if (initial_layout == image_layout_map::kInvalidLayout) {
+
+        const auto subresource_count = image_state->subresource_encoder.SubresourceCount();
+        const auto [it, first_use] = submission_image_layout_map.try_emplace(image_state.get(), subresource_count);
+
+        // If no earlier command buffer of this submission used the image, the command buffer expectations are checked against
+        // the global layouts only. When those did not change since the registry last passed validation there is nothing to walk.
+        if (first_use && image_layout_registry->ValidatedVersion() != 0) {
+            auto global_layout_map_guard = global_layout_map->ReadLock();
+            if (image_layout_registry->ValidatedVersion() == global_layout_map->Version()) {
+                sparse_container::splice(*it->second, cb_layout_map, GlobalLayoutUpdater());
                 continue;
             }
+        }
+        checks.emplace_back(ImageCheck{image_state.get(), image_layout_registry.get(), nullptr, first_use});
+        image_states.emplace_back(std::move(image_state));
+    }
+    // Taken once all images are inserted, the map may move its values while growing
+    for (ImageCheck &check : checks) {
+        check.submission_layout_map = &*submission_image_layout_map.find(check.image_state)->second;
+    }
 
-            VkImageLayout image_layout = kInvalidLayout;
+    const uint32_t count = static_cast<uint32_t>(checks.size());
+    auto validate = [&](uint32_t i) {
+        const ImageCheck &check = checks[i];
+        return ValidateCmdBufImageLayout(loc, cb_state, *check.image_state, *check.registry, *check.submission_layout_map,
+                                         check.first_use);
+    };
 
-            if (current_layout->range.empty()) break;  // When we are past the end of data in overlay and global... stop looking
-            if (current_layout->pos_A->valid) {        // pos_A denotes the overlay map in the parallel iterator
-                image_layout = current_layout->pos_A->lower_bound->second;
-            } else if (current_layout->pos_B->valid) {  // pos_B denotes the global map in the parallel iterator
-                image_layout = current_layout->pos_B->lower_bound->second;
-            }
-            const auto intersected_range = pos->first & current_layout->range;
-            if (initial_layout == VK_IMAGE_LAYOUT_UNDEFINED) {
-                // TODO: Set memory invalid which is in mem_tracker currently
-            } else if (image_layout != initial_layout) {
-                const auto aspect_mask = image_state->subresource_encoder.Decode(intersected_range.begin).aspectMask;
-                const bool matches = ImageLayoutMatches(aspect_mask, image_layout, initial_layout);
-                if (!matches) {
-                    // We can report all the errors for the intersected range directly
-                    for (auto index : vvl::range_view<decltype(intersected_range)>(intersected_range)) {
-                        const auto subresource = image_state->subresource_encoder.Decode(index);
-                        const LogObjectList objlist(cb_state.Handle(), image_state->Handle());
-                        // TODO - We need a way to map the action command to which caused this error
-                        const vvl::DrawDispatchVuid &vuid = GetDrawDispatchVuid(vvl::Func::vkCmdDraw);
-                        skip |= LogError(
-                            vuid.image_layout_09600, objlist, loc,
-                            "command buffer %s expects %s (subresource: %s) to be in layout %s--instead, current layout is %s.",
-                            FormatHandle(cb_state).c_str(), FormatHandle(*image_state).c_str(),
-                            string_VkImageSubresource(subresource).c_str(), string_VkImageLayout(initial_layout),
-                            string_VkImageLayout(image_layout));
-                    }
+    // Walking the layouts of a few images is cheaper than handing them to other threads
+    constexpr uint32_t kMinParallelImages = 16;
+    if (count < kMinParallelImages || device_state->thread_pool.MaxWorkers() == 0) {
+        bool skip = false;
+        for (uint32_t i = 0; i < count; i++) {
+            skip |= validate(i);
+        }
+        return skip;
+    }
+
+    // Every check reads the global layouts of its image and writes only the submission layouts of that image, so the images
+    // can be checked independently. Messages are reported afterwards in command buffer order.
+    std::vector<DeferredLog> logs(count);
+    std::vector<uint8_t> skips(count, 0);
+    device_state->thread_pool.ParallelFor(count, [&](uint32_t i) {
+        DeferredLogScope log_scope(logs[i]);
+        skips[i] = validate(i) ? 1 : 0;
+    });
+
+    bool skip = false;
+    for (uint32_t i = 0; i < count; i++) {
+        skip |= skips[i] != 0;
+        skip |= logs[i].Replay(*debug_report);
+    }
+    return skip;
+}
+
+// Validates the initial layouts of a single image and records the command buffer layouts in the submission layouts.
+// first_use means no earlier command buffer of the submission used the image, so the submission layouts are empty.
+bool CoreChecks::ValidateCmdBufImageLayout(const Location &loc, const vvl::CommandBuffer &cb_state, const vvl::Image &image_state,
+                                           const image_layout_map::ImageLayoutRegistry &image_layout_registry,
+                                           ImageLayoutRangeMap &submission_layout_map, bool first_use) const {
+    bool skip = false;
+    bool found_mismatch = false;
+    const auto &cb_layout_map = image_layout_registry.GetLayoutMap();
+    const auto *global_layout_map = image_state.layout_range_map.get();
+    auto global_layout_map_guard = global_layout_map->ReadLock();
+
+    // Note: don't know if it would matter
+    // if (global_range_map->empty() && overlay_map->empty()) // skip this next loop...;
+
+    auto pos = cb_layout_map.begin();
+    const auto end = cb_layout_map.end();
+    sparse_container::parallel_iterator<const ImageLayoutRangeMap> current_layout(submission_layout_map, *global_layout_map,
+                                                                                  pos->first.begin);
+    while (pos != end) {
+        VkImageLayout initial_layout = pos->second.initial_layout;
+        if (initial_layout == image_layout_map::kInvalidLayout) {
+            continue;
+        }
+
+        VkImageLayout image_layout = kInvalidLayout;
+
+        if (current_layout->range.empty()) break;  // When we are past the end of data in overlay and global... stop looking
+        if (current_layout->pos_A->valid) {        // pos_A denotes the overlay map in the parallel iterator
+            image_layout = current_layout->pos_A->lower_bound->second;
+        } else if (current_layout->pos_B->valid) {  // pos_B denotes the global map in the parallel iterator
+            image_layout = current_layout->pos_B->lower_bound->second;
+        }
+        const auto intersected_range = pos->first & current_layout->range;
+        if (initial_layout == VK_IMAGE_LAYOUT_UNDEFINED) {
+            // TODO: Set memory invalid which is in mem_tracker currently
+        } else if (image_layout != initial_layout) {
+            const auto aspect_mask = image_state.subresource_encoder.Decode(intersected_range.begin).aspectMask;
+            const bool matches = ImageLayoutMatches(aspect_mask, image_layout, initial_layout);
+            if (!matches) {
+                found_mismatch = true;
+                // We can report all the errors for the intersected range directly
+                for (auto index : vvl::range_view<decltype(intersected_range)>(intersected_range)) {
+                    const auto subresource = image_state.subresource_encoder.Decode(index);
+                    const LogObjectList objlist(cb_state.Handle(), image_state.Handle());
+                    // TODO - We need a way to map the action command to which caused this error
+                    const vvl::DrawDispatchVuid &vuid = GetDrawDispatchVuid(vvl::Func::vkCmdDraw);
+                    skip |= LogError(
+                        vuid.image_layout_09600, objlist, loc,
+                        "command buffer %s expects %s (subresource: %s) to be in layout %s--instead, current layout is %s.",
+                        FormatHandle(cb_state).c_str(), FormatHandle(image_state).c_str(),
+                        string_VkImageSubresource(subresource).c_str(), string_VkImageLayout(initial_layout),
+                        string_VkImageLayout(image_layout));
                 }
             }
-            if (pos->first.includes(intersected_range.end)) {
-                current_layout.seek(intersected_range.end);
-            } else {
-                ++pos;
-                if (pos != end) {
-                    current_layout.seek(pos->first.begin);
-                }
+        }
+        if (pos->first.includes(intersected_range.end)) {
+            current_layout.seek(intersected_range.end);
+        } else {
+            ++pos;
+            if (pos != end) {
+                current_layout.seek(pos->first.begin);
             }
         }
-        // Update all layout set operations (which will be a subset of the initial_layouts)
-        sparse_container::splice(submission_layout_map, cb_layout_map, GlobalLayoutUpdater());
     }
-
+    // Only checked against the global layouts, so the result holds until they change
+    if (first_use && !found_mismatch) {
+        image_layout_registry.SetValidatedVersion(global_layout_map->Version());
+    }
+    // Update all layout set operations (which will be a subset of the initial_layouts)
+    sparse_container::splice(submission_layout_map, cb_layout_map, GlobalLayoutUpdater());
     return skip;
 }
 
@@ -277,7 +351,10 @@ void CoreChecks::UpdateCmdBufImageLayouts(const vvl::CommandBuffer &cb_state) {
         const auto image_state = Get<vvl::Image>(image);
         if (image_state && image_layout_registry && image_state->GetId() == image_layout_registry->GetImageId()) {
             auto guard = image_state->layout_range_map->WriteLock();
-            sparse_container::splice(*image_state->layout_range_map, image_layout_registry->GetLayoutMap(), GlobalLayoutUpdater());
+            if (sparse_container::splice(*image_state->layout_range_map, image_layout_registry->GetLayoutMap(),
+                                         GlobalLayoutUpdater())) {
+                image_state->layout_range_map->BumpVersion();
+            }
         }
     }
 }
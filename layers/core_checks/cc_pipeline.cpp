@@ -44,6 +44,35 @@ bool CoreChecks::IsBeforeCtsVersion(uint32_t major, uint32_t minor, uint32_t sub
     return phys_dev_props_core12.conformanceVersion.subminor < subminor;
 }
 
+bool CoreChecks::ValidatePipelineCreateInfos(uint32_t count, const std::function<bool(uint32_t)> &validate) const {
+    // Handing a couple of pipelines to other threads costs more than validating them here
+    constexpr uint32_t kMinParallelCreateInfos = 4;
+    if (count < kMinParallelCreateInfos || device_state->thread_pool.MaxWorkers() == 0) {
+        bool skip = false;
+        for (uint32_t i = 0; i < count; i++) {
+            skip |= validate(i);
+        }
+        return skip;
+    }
+
+    // Validation only reads state (the same functions already run concurrently when the application creates pipelines from
+    // several threads), so the create infos can be checked independently. Messages are collected per create info and reported
+    // afterwards on this thread, so the output does not depend on how the work got scheduled.
+    std::vector<DeferredLog> logs(count);
+    std::vector<uint8_t> skips(count, 0);
+    device_state->thread_pool.ParallelFor(count, [&](uint32_t i) {
+        DeferredLogScope log_scope(logs[i]);
+        skips[i] = validate(i) ? 1 : 0;
+    });
+
+    bool skip = false;
+    for (uint32_t i = 0; i < count; i++) {
+        skip |= skips[i] != 0;
+        skip |= logs[i].Replay(*debug_report);
+    }
+    return skip;
+}
+
 bool CoreChecks::ValidatePipelineCacheControlFlags(VkPipelineCreateFlags2 flags, const Location &flags_loc,
                                                    const char *vuid) const {
     bool skip = false;
@@ -28,12 +28,10 @@ bool CoreChecks::PreCallValidateCreateComputePipelines(VkDevice device, VkPipeli
                                                        const VkAllocationCallbacks *pAllocator, VkPipeline *pPipelines,
                                                        const ErrorObject &error_obj, PipelineStates &pipeline_states,
                                                        chassis::CreateComputePipelines &chassis_state) const {
-    bool skip = false;
-
-    skip |= ValidateDeviceQueueSupport(error_obj.location);
-    for (uint32_t i = 0; i < count; i++) {
+    auto validate_create_info = [&](uint32_t i) {
+        bool skip = false;
         const vvl::Pipeline *pipeline = pipeline_states[i].get();
-        ASSERT_AND_CONTINUE(pipeline);
+        ASSERT_AND_RETURN_SKIP(pipeline);
 
         const Location create_info_loc = error_obj.location.dot(Field::pCreateInfos, i);
         const Location stage_info = create_info_loc.dot(Field::stage);
@@ -63,7 +61,12 @@ bool CoreChecks::PreCallValidateCreateComputePipelines(VkDevice device, VkPipeli
                 *chassis_state.stateless_data.pipeline_pnext_module, chassis_state.stateless_data,
                 create_info_loc.dot(Field::stage).pNext(Struct::VkShaderModuleCreateInfo, Field::pCode));
         }
-    }
+        return skip;
+    };
+
+    bool skip = false;
+    skip |= ValidateDeviceQueueSupport(error_obj.location);
+    skip |= ValidatePipelineCreateInfos(count, validate_create_info);
     return skip;
 }
 
@@ -17,9 +17,12 @@
  * limitations under the License.
  */
 
+#include <atomic>
 #include <cassert>
 #include <cinttypes>
+#include <condition_variable>
 #include <cstdint>
+#include <mutex>
 #include <spirv/unified1/spirv.hpp>
 #include <sstream>
 #include <string>
@@ -1739,6 +1742,9 @@ bool CoreChecks::ValidateShaderStage(const ShaderStageState &stage_state, const
     const spirv::Module &module_state = *stage_state.spirv_state.get();
     if (!module_state.valid_spirv) return skip;  // checked elsewhere
 
+    // First use of the module, spirv-val must have finished before we rely on the SPIR-V being valid
+    skip |= WaitForSpirvValidation(module_state);
+
     if (!stage_state.entrypoint) {
         const char *vuid = pipeline ? "VUID-VkPipelineShaderStageCreateInfo-pName-00707" : "VUID-VkShaderCreateInfoEXT-pName-08440";
         std::stringstream err;
@@ -2099,6 +2105,49 @@ void CoreChecks::PreCallRecordCreateShadersEXT(VkDevice device, uint32_t createI
     }
 }
 
+struct CoreChecks::PendingSpirvValidation {
+    // Copy of the SPIR-V, the application is free to release pCode once vkCreateShaderModule returns
+    std::vector<uint32_t> words;
+    LocationCapture loc;
+    ValidationCache *cache;
+    uint64_t cache_key;
+    DeferredLog log;
+
+    std::atomic<bool> started{false};
+    std::mutex lock;
+    std::condition_variable cond;
+    bool done = false;
+
+    PendingSpirvValidation(const spv_const_binary_t &binary, const Location &create_info_loc, ValidationCache *cache_,
+                           uint64_t cache_key_)
+        : words(binary.code, binary.code + binary.wordCount), loc(create_info_loc), cache(cache_), cache_key(cache_key_) {}
+
+    // Whoever gets here first does the work, the other caller returns right away
+    void Run(const CoreChecks &core_checks) {
+        if (started.exchange(true)) {
+            return;
+        }
+        {
+            DeferredLogScope log_scope(log);
+            spv_const_binary_t binary{words.data(), words.size()};
+            core_checks.ExecuteSpirvValidation(binary, loc.Get(), cache, cache_key);
+        }
+        words = std::vector<uint32_t>();
+
+        std::unique_lock<std::mutex> guard(lock);
+        done = true;
+        cond.notify_all();
+    }
+
+    // Runs the validation on the calling thread if no worker picked it up yet. Waiting on the queued task instead could
+    // deadlock when called from a worker (ex. pipelines validated in parallel).
+    void Wait(const CoreChecks &core_checks) {
+        Run(core_checks);
+        std::unique_lock<std::mutex> guard(lock);
+        cond.wait(guard, [this]() { return done; });
+    }
+};
+
 bool CoreChecks::RunSpirvValidation(spv_const_binary_t &binary, const Location &loc, ValidationCache *cache) const {
     bool skip = false;
 
@@ -2106,20 +2155,93 @@ bool CoreChecks::RunSpirvValidation(spv_const_binary_t &binary, const Location &
         return skip;
     }
 
-    uint32_t hash = 0;
-    if (cache) {
-        hash = hash_util::Hash32((void *)binary.code, binary.wordCount * sizeof(uint32_t));
-        if (cache->Contains(hash)) {
+    // Only vkCreateShaderModule can be deferred, inlined SPIR-V (pipeline pNext, shader objects) is used right away.
+    // An application provided VkValidationCacheEXT could be destroyed while spirv-val is still running, so only the
+    // device owned cache is used from the background.
+    const bool run_async = global_settings.async_spirv_val && loc.function == Func::vkCreateShaderModule &&
+                           (!cache || cache == CastFromHandle<ValidationCache *>(core_validation_cache));
+
+    // The cache key also identifies the module while its validation is pending, so the SPIR-V is only hashed once
+    uint64_t cache_key = 0;
+    if (cache || run_async) {
+        cache_key = ValidationCache::GetKey(binary.code, binary.wordCount);
+        if (cache && cache->Contains(cache_key)) {
             return skip;
         }
     }
 
+    if (run_async) {
+        QueueSpirvValidation(binary, loc, cache, cache_key);
+        return skip;
+    }
+
+    return ExecuteSpirvValidation(binary, loc, cache, cache_key);
+}
+
+void CoreChecks::QueueSpirvValidation(spv_const_binary_t &binary, const Location &loc, ValidationCache *cache,
+                                      uint64_t cache_key) const {
+    std::shared_ptr<PendingSpirvValidation> pending;
+    {
+        std::unique_lock<std::mutex> guard(pending_spirv_val_lock);
+        auto &entry = pending_spirv_val[cache_key];
+        if (entry) {
+            return;  // Same SPIR-V is already being validated
+        }
+        entry = std::make_shared<PendingSpirvValidation>(binary, loc, cache, cache_key);
+        pending = entry;
+    }
+
+    // Everything pending is waited on in PreCallRecordDestroyDevice, so "this" and the cache outlive the task
+    device_state->thread_pool.Post([this, pending]() { pending->Run(*this); });
+}
+
+bool CoreChecks::WaitForSpirvValidation(const spirv::Module &module_state) const {
+    if (!global_settings.async_spirv_val) {
+        return false;
+    }
+
+    std::shared_ptr<PendingSpirvValidation> pending;
+    {
+        std::unique_lock<std::mutex> guard(pending_spirv_val_lock);
+        if (pending_spirv_val.empty()) {
+            return false;
+        }
+        auto it = pending_spirv_val.find(ValidationCache::GetKey(module_state.words_.data(), module_state.words_.size()));
+        if (it == pending_spirv_val.end()) {
+            return false;
+        }
+        // Results are only reported once, just like they would be from vkCreateShaderModule
+        pending = std::move(it->second);
+        pending_spirv_val.erase(it);
+    }
+
+    pending->Wait(*this);
+    return pending->log.Replay(*debug_report);
+}
+
+bool CoreChecks::WaitForAllSpirvValidation() const {
+    vvl::unordered_map<uint64_t, std::shared_ptr<PendingSpirvValidation>> pending;
+    {
+        std::unique_lock<std::mutex> guard(pending_spirv_val_lock);
+        pending.swap(pending_spirv_val);
+    }
+
+    bool skip = false;
+    for (auto &entry : pending) {
+        entry.second->Wait(*this);
+        skip |= entry.second->log.Replay(*debug_report);
+    }
+    return skip;
+}
+
+bool CoreChecks::ExecuteSpirvValidation(spv_const_binary_t &binary, const Location &loc, ValidationCache *cache,
+                                        uint64_t cache_key) const {
+    bool skip = false;
+
     // Use SPIRV-Tools validator to try and catch any issues with the module itself. If specialization constants are present,
     // the default values will be used during validation.
-    spv_target_env spirv_environment = PickSpirvEnv(api_version, IsExtEnabled(extensions.vk_khr_spirv_1_4));
-    spv_context ctx = spvContextCreate(spirv_environment);
     spv_diagnostic diag = nullptr;
-    const spv_result_t spv_valid = spvValidateWithOptions(ctx, spirv_val_options, &binary, &diag);
+    const spv_result_t spv_valid = spvValidateWithOptions(spirv_val_context, spirv_val_options, &binary, &diag);
     if (spv_valid != SPV_SUCCESS) {
         const char *error_message = diag && diag->error ? diag->error : "(no error text)";
 
@@ -2158,11 +2280,10 @@ bool CoreChecks::RunSpirvValidation(spv_const_binary_t &binary, const Location &
         }
     } else if (cache) {
         // No point to cache anything that is not valid, or it will get suppressed on the next run
-        cache->Insert(hash);
+        cache->Insert(cache_key);
     }
 
     spvDiagnosticDestroy(diag);
-    spvContextDestroy(ctx);
 
     return skip;
 }
@@ -74,6 +74,13 @@ struct TimelineMaxDiffCheck {
 
     bool operator()(const vvl::Semaphore::OpType, uint64_t payload, bool is_pending) { return AbsDiff(value, payload) > max_diff; }
 
+    // Same check against the operations already known to the semaphore, every payload outside this range exceeds max_diff
+    std::optional<vvl::Semaphore::SemOp> LastOp(const vvl::Semaphore &semaphore_state) const {
+        const uint64_t min_payload = value > max_diff ? value - max_diff : 0;
+        const uint64_t max_payload = max_diff > vvl::kU64Max - value ? vvl::kU64Max : value + max_diff;
+        return semaphore_state.LastOpOutsideRange(min_payload, max_payload);
+    }
+
     uint64_t value;
     uint64_t max_diff;
 };
@@ -122,9 +129,9 @@ VkQueue SemaphoreSubmitState::AnotherQueueWaits(const vvl::Semaphore &semaphore_
     return VK_NULL_HANDLE;
 }
 
-bool SemaphoreSubmitState::CheckSemaphoreValue(
-    const vvl::Semaphore &semaphore_state, std::string &where, uint64_t &bad_value,
-    std::function<bool(const vvl::Semaphore::OpType, uint64_t, bool is_pending)> compare_func) {
+template <typename Filter>
+bool SemaphoreSubmitState::CheckSemaphoreValue(const vvl::Semaphore &semaphore_state, std::string &where, uint64_t &bad_value,
+                                               Filter &&compare_func, const std::optional<vvl::Semaphore::SemOp> &pending) {
     auto current_signal = timeline_signals.find(semaphore_state.VkHandle());
     // NOTE: for purposes of validation, duplicate operations in the same submission are not yet pending.
     if (current_signal != timeline_signals.end()) {
@@ -142,7 +149,6 @@ bool SemaphoreSubmitState::CheckSemaphoreValue(
             return true;
         }
     }
-    auto pending = semaphore_state.LastOp(compare_func);
     if (pending) {
         if (pending->payload == semaphore_state.CurrentPayload()) {
             where = "current";
@@ -205,7 +211,8 @@ bool SemaphoreSubmitState::ValidateWaitSemaphore(const Location &wait_semaphore_
             std::string where;
             TimelineMaxDiffCheck exceeds_max_diff(value, core.phys_dev_props_core12.maxTimelineSemaphoreValueDifference);
             const VkSemaphore handle = semaphore_state.VkHandle();
-            if (CheckSemaphoreValue(semaphore_state, where, bad_value, exceeds_max_diff)) {
+            if (CheckSemaphoreValue(semaphore_state, where, bad_value, exceeds_max_diff,
+                                    exceeds_max_diff.LastOp(semaphore_state))) {
                 const auto &vuid = GetQueueSubmitVUID(wait_semaphore_loc, SubmitError::kTimelineSemMaxDiff);
                 skip |= core.LogError(vuid, handle, wait_semaphore_loc,
                                       "value (%" PRIu64 ") exceeds limit regarding %s semaphore %s value (%" PRIu64 ").", value,
@@ -361,7 +368,9 @@ bool SemaphoreSubmitState::ValidateSignalSemaphore(const Location &signal_semaph
                 // exact value ordering cannot be determined until execution time
                 return !is_pending && value < payload;
             };
-            if (CheckSemaphoreValue(semaphore_state, where, bad_value, must_be_greater)) {
+            // Only signals with a payload >= value can match
+            if (CheckSemaphoreValue(semaphore_state, where, bad_value, must_be_greater,
+                                    semaphore_state.LastOp(must_be_greater, value))) {
                 const auto &vuid = GetQueueSubmitVUID(signal_semaphore_loc, SubmitError::kTimelineSemSmallValue);
                 skip |= core.LogError(
                     vuid, objlist, signal_semaphore_loc,
@@ -370,7 +379,8 @@ bool SemaphoreSubmitState::ValidateSignalSemaphore(const Location &signal_semaph
                 break;
             }
             TimelineMaxDiffCheck exceeds_max_diff(value, core.phys_dev_props_core12.maxTimelineSemaphoreValueDifference);
-            if (CheckSemaphoreValue(semaphore_state, where, bad_value, exceeds_max_diff)) {
+            if (CheckSemaphoreValue(semaphore_state, where, bad_value, exceeds_max_diff,
+                                    exceeds_max_diff.LastOp(semaphore_state))) {
                 const auto &vuid = GetQueueSubmitVUID(signal_semaphore_loc, SubmitError::kTimelineSemMaxDiff);
                 skip |= core.LogError(vuid, objlist, signal_semaphore_loc,
                                       "value (%" PRIu64 ") exceeds limit regarding %s semaphore %s value (%" PRIu64 ").", value,
@@ -1565,10 +1575,8 @@ bool CoreChecks::PreCallValidateSignalSemaphore(VkDevice device, const VkSemapho
                          FormatHandle(pSignalInfo->semaphore).c_str(), current_payload);
         return skip;
     }
-    auto exceeds_pending = [pSignalInfo](const vvl::Semaphore::OpType op_type, uint64_t payload, bool is_pending) {
-        return is_pending && op_type == vvl::Semaphore::OpType::kSignal && pSignalInfo->value >= payload;
-    };
-    auto last_op = semaphore_state->LastOp(exceeds_pending);
+    // Any pending signal with a payload <= value
+    auto last_op = semaphore_state->LastPendingSignal(pSignalInfo->value);
     if (last_op) {
         skip |= LogError("VUID-VkSemaphoreSignalInfo-value-03259", pSignalInfo->semaphore, signal_loc.dot(Field::value),
                          "(%" PRIu64 ") must be less than value of any pending signal operation (%" PRIu64 ") for semaphore %s.",
@@ -1579,7 +1587,7 @@ bool CoreChecks::PreCallValidateSignalSemaphore(VkDevice device, const VkSemapho
     uint64_t bad_value = 0;
     const char *where = nullptr;
     TimelineMaxDiffCheck exceeds_max_diff(pSignalInfo->value, phys_dev_props_core12.maxTimelineSemaphoreValueDifference);
-    last_op = semaphore_state->LastOp(exceeds_max_diff);
+    last_op = exceeds_max_diff.LastOp(*semaphore_state);
     if (last_op) {
         bad_value = last_op->payload;
         if (last_op->payload == semaphore_state->CurrentPayload()) {
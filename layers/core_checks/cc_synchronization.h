@@ -45,8 +45,11 @@ struct SemaphoreSubmitState {
     bool CanWaitBinary(const vvl::Semaphore &semaphore_state) const;
     bool CanSignalBinary(const vvl::Semaphore &semaphore_state, VkQueue &other_queue, vvl::Func &other_acquire_command) const;
 
-    bool CheckSemaphoreValue(const vvl::Semaphore &semaphore_state, std::string &where, uint64_t &bad_value,
-                             std::function<bool(const vvl::Semaphore::OpType, uint64_t, bool is_pending)> compare_func);
+    // compare_func is applied to the operations of the current submission, pending is the result of the matching query on
+    // the semaphore itself
+    template <typename Filter>
+    bool CheckSemaphoreValue(const vvl::Semaphore &semaphore_state, std::string &where, uint64_t &bad_value, Filter &&compare_func,
+                             const std::optional<vvl::Semaphore::SemOp> &pending);
 
     VkQueue AnotherQueueWaits(const vvl::Semaphore &semaphore_state) const;
 
@@ -223,8 +223,16 @@ class CoreChecks : public vvl::DeviceProxy {
     // the second time).
     spvtools::ValidatorOptions spirv_val_options;
     uint32_t spirv_val_option_hash;
+    // The target environment only depends on the device, so a single context is shared by every spirv-val call
+    spv_context spirv_val_context = nullptr;
     stateless::SpirvValidator stateless_spirv_validator;
 
+    // When spirv-val runs in the background (check_shaders_async), the results are keyed by the validation cache key of the
+    // SPIR-V and reported the first time a module with that content is used (or when the device is destroyed)
+    struct PendingSpirvValidation;
+    mutable std::mutex pending_spirv_val_lock;
+    mutable vvl::unordered_map<uint64_t, std::shared_ptr<PendingSpirvValidation>> pending_spirv_val;
+
     CoreChecks(vvl::dispatch::Device* dev, core::Instance* instance_vo)
         : BaseClass(dev, instance_vo, LayerObjectTypeCoreValidation),
           stateless_spirv_validator(dev->debug_report, dev->stateless_device_data) {}
@@ -241,6 +249,9 @@ class CoreChecks : public vvl::DeviceProxy {
                                       const char* vuid) const;
     bool ValidateGraphicsPipelineDerivatives(PipelineStates& pipeline_states, uint32_t pipe_index, const Location& loc) const;
     bool ValidateComputePipelineDerivatives(PipelineStates& pipeline_states, uint32_t pipe_index, const Location& loc) const;
+    // Calls validate(i) for each create info of a vkCreate*Pipelines call. Large batches are spread over the device thread pool,
+    // messages are still reported in create info order.
+    bool ValidatePipelineCreateInfos(uint32_t count, const std::function<bool(uint32_t)>& validate) const;
     bool ValidateMultiViewShaders(const vvl::Pipeline& pipeline, const Location& multiview_loc, uint32_t view_mask,
                                   bool dynamic_rendering) const;
     bool ValidateGraphicsPipeline(const vvl::Pipeline& pipeline, const void* pipeline_ci_pnext,
@@ -881,6 +892,10 @@ class CoreChecks : public vvl::DeviceProxy {
                                        const VkAllocationCallbacks* pAllocator, VkShaderEXT* pShaders,
                                        const RecordObject& record_obj, chassis::ShaderObject& chassis_state) override;
     bool RunSpirvValidation(spv_const_binary_t& binary, const Location& loc, ValidationCache* cache) const;
+    bool ExecuteSpirvValidation(spv_const_binary_t& binary, const Location& loc, ValidationCache* cache, uint64_t cache_key) const;
+    void QueueSpirvValidation(spv_const_binary_t& binary, const Location& loc, ValidationCache* cache, uint64_t cache_key) const;
+    bool WaitForSpirvValidation(const spirv::Module& module_state) const;
+    bool WaitForAllSpirvValidation() const;
     bool ValidateShaderModuleCreateInfo(const VkShaderModuleCreateInfo& create_info, const Location& create_info_loc) const;
     bool PreCallValidateCreateShaderModule(VkDevice device, const VkShaderModuleCreateInfo* pCreateInfo,
                                            const VkAllocationCallbacks* pAllocator, VkShaderModule* pShaderModule,
@@ -1187,6 +1202,9 @@ class CoreChecks : public vvl::DeviceProxy {
 
     bool ValidateCmdBufImageLayouts(const Location& loc, const vvl::CommandBuffer& cb_state,
                                     SubmissionImageLayoutMap& submission_image_layout_map) const;
+    bool ValidateCmdBufImageLayout(const Location& loc, const vvl::CommandBuffer& cb_state, const vvl::Image& image_state,
+                                   const image_layout_map::ImageLayoutRegistry& image_layout_registry,
+                                   ImageLayoutRangeMap& submission_layout_map, bool first_use) const;
 
     void UpdateCmdBufImageLayouts(const vvl::CommandBuffer& cb_state);
 
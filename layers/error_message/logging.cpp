@@ -96,6 +96,35 @@ void DebugReport::RemoveDebugUtilsCallback(uint64_t callback) {
     SetDebugUtilsSeverityFlags(callbacks);
 }
 
+// Set while a DeferredLogScope is active on this thread
+static thread_local DeferredLog *active_deferred_log = nullptr;
+
+struct DeferredLog::Message {
+    VkFlags msg_flags;
+    std::string vuid_text;
+    LogObjectList objects;
+    LocationCapture loc;
+    std::string main_message;
+};
+
+DeferredLog::DeferredLog() = default;
+DeferredLog::~DeferredLog() = default;
+DeferredLog::DeferredLog(DeferredLog &&) = default;
+DeferredLog &DeferredLog::operator=(DeferredLog &&) = default;
+
+bool DeferredLog::Replay(DebugReport &debug_report) const {
+    bool skip = false;
+    for (const Message &message : messages_) {
+        skip |= debug_report.LogMessage(message.msg_flags, message.vuid_text, message.objects, message.loc.Get(),
+                                        message.main_message);
+    }
+    return skip;
+}
+
+DeferredLogScope::DeferredLogScope(DeferredLog &log) : prev_log_(active_deferred_log) { active_deferred_log = &log; }
+
+DeferredLogScope::~DeferredLogScope() { active_deferred_log = prev_log_; }
+
 // We try to return as early as we can if we know we don't need to spend time logging the message
 bool DebugReport::LogMessage(VkFlags msg_flags, std::string_view vuid_text, const LogObjectList &objects, const Location &loc,
                              const std::string &main_message) {
@@ -113,6 +142,13 @@ bool DebugReport::LogMessage(VkFlags msg_flags, std::string_view vuid_text, cons
         return false;
     }
 
+    // The message limit and the callbacks are only applied once the message is replayed on the calling thread
+    if (active_deferred_log) {
+        active_deferred_log->messages_.emplace_back(
+            DeferredLog::Message{msg_flags, std::string(vuid_text), objects, LocationCapture(loc), main_message});
+        return false;
+    }
+
     // We have a few speical VUID we never actually want to suppress.
     // If a new VUID is added here, make sure to add it in VkLayerTest.VuidHashStability test as well.
     const bool skip_checking_limit =
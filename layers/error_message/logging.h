@@ -334,6 +334,37 @@ class Logger {
     DebugReport *debug_report{nullptr};
 };
 
+// While a DeferredLogScope is alive, every message logged on that thread is stored in the DeferredLog instead of being
+// reported. This lets validation that runs on worker threads hand its messages back to the calling thread, which then
+// reports them in a fixed order no matter how the work was scheduled.
+class DeferredLog {
+  public:
+    DeferredLog();
+    ~DeferredLog();
+    DeferredLog(DeferredLog &&);
+    DeferredLog &operator=(DeferredLog &&);
+
+    // Reports all stored messages through debug_report, returns true if any callback asked to skip the call
+    bool Replay(DebugReport &debug_report) const;
+
+  private:
+    friend class DebugReport;
+    struct Message;
+    std::vector<Message> messages_;
+};
+
+class DeferredLogScope {
+  public:
+    explicit DeferredLogScope(DeferredLog &log);
+    ~DeferredLogScope();
+
+    DeferredLogScope(const DeferredLogScope &) = delete;
+    DeferredLogScope &operator=(const DeferredLogScope &) = delete;
+
+  private:
+    DeferredLog *prev_log_;
+};
+
 VKAPI_ATTR VkResult LayerCreateMessengerCallback(DebugReport *debug_report, bool default_callback,
                                                  const VkDebugUtilsMessengerCreateInfoEXT *create_info,
                                                  VkDebugUtilsMessengerEXT *messenger);
@@ -255,7 +255,10 @@ void UpdateCmdBufImageLayouts(Validator &gpuav, const vvl::CommandBuffer &cb_sta
         auto image_state = gpuav.Get<vvl::Image>(image);
         if (image_state && image_state->GetId() == image_layout_registry->GetImageId()) {
             auto guard = image_state->layout_range_map->WriteLock();
-            sparse_container::splice(*image_state->layout_range_map, image_layout_registry->GetLayoutMap(), GlobalLayoutUpdater());
+            if (sparse_container::splice(*image_state->layout_range_map, image_layout_registry->GetLayoutMap(),
+                                         GlobalLayoutUpdater())) {
+                image_state->layout_range_map->BumpVersion();
+            }
         }
     }
 }
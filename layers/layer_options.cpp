@@ -153,6 +153,7 @@ const char *VK_LAYER_OBJECT_LIFETIME = "object_lifetime";
 const char *VK_LAYER_VALIDATE_CORE = "validate_core";
 const char *VK_LAYER_UNIQUE_HANDLES = "unique_handles";
 const char *VK_LAYER_CHECK_SHADERS_CACHING = "check_shaders_caching";
+const char *VK_LAYER_CHECK_SHADERS_ASYNC = "check_shaders_async";
 
 // Additional checks exposed in vkconfig, but not in VkValidationFeatureDisableEXT
 // ---
@@ -223,6 +224,11 @@ const char *VK_LAYER_GPUAV_DEBUG_PRINT_INSTRUMENTATION_INFO = "gpuav_debug_print
 const char *VK_LAYER_SYNCVAL_SUBMIT_TIME_VALIDATION = "syncval_submit_time_validation";
 const char *VK_LAYER_SYNCVAL_SHADER_ACCESSES_HEURISTIC = "syncval_shader_accesses_heuristic";
 const char *VK_LAYER_SYNCVAL_MESSAGE_EXTRA_PROPERTIES = "syncval_message_extra_properties";
+const char *VK_LAYER_SYNCVAL_MAX_RETAINED_SUBMITS = "syncval_max_retained_submits";
+const char *VK_LAYER_SYNCVAL_MAX_RETAINED_HISTORY_MB = "syncval_max_retained_history_mb";
+const char *VK_LAYER_SYNCVAL_TELEMETRY = "syncval_telemetry";
+const char *VK_LAYER_SYNCVAL_TELEMETRY_REPORT_INTERVAL = "syncval_telemetry_report_interval";
+const char *VK_LAYER_SYNCVAL_TELEMETRY_FILENAME = "syncval_telemetry_filename";
 
 // Message Formatting
 // ---
@@ -555,6 +561,8 @@ static void ValidateLayerSettingsProvided(const VkLayerSettingsCreateInfoEXT *la
             required_type = VK_LAYER_SETTING_TYPE_BOOL32_EXT;
         } else if (strcmp(VK_LAYER_CHECK_SHADERS_CACHING, setting.pSettingName) == 0) {
             required_type = VK_LAYER_SETTING_TYPE_BOOL32_EXT;
+        } else if (strcmp(VK_LAYER_CHECK_SHADERS_ASYNC, setting.pSettingName) == 0) {
+            required_type = VK_LAYER_SETTING_TYPE_BOOL32_EXT;
         } else if (strcmp(VK_LAYER_CHECK_COMMAND_BUFFER, setting.pSettingName) == 0) {
             required_type = VK_LAYER_SETTING_TYPE_BOOL32_EXT;
         } else if (strcmp(VK_LAYER_CHECK_OBJECT_IN_USE, setting.pSettingName) == 0) {
@@ -631,6 +639,16 @@ static void ValidateLayerSettingsProvided(const VkLayerSettingsCreateInfoEXT *la
             required_type = VK_LAYER_SETTING_TYPE_BOOL32_EXT;
         } else if (strcmp(VK_LAYER_SYNCVAL_MESSAGE_EXTRA_PROPERTIES, setting.pSettingName) == 0) {
             required_type = VK_LAYER_SETTING_TYPE_BOOL32_EXT;
+        } else if (strcmp(VK_LAYER_SYNCVAL_MAX_RETAINED_SUBMITS, setting.pSettingName) == 0) {
+            required_type = VK_LAYER_SETTING_TYPE_UINT32_EXT;
+        } else if (strcmp(VK_LAYER_SYNCVAL_MAX_RETAINED_HISTORY_MB, setting.pSettingName) == 0) {
+            required_type = VK_LAYER_SETTING_TYPE_UINT32_EXT;
+        } else if (strcmp(VK_LAYER_SYNCVAL_TELEMETRY, setting.pSettingName) == 0) {
+            required_type = VK_LAYER_SETTING_TYPE_BOOL32_EXT;
+        } else if (strcmp(VK_LAYER_SYNCVAL_TELEMETRY_REPORT_INTERVAL, setting.pSettingName) == 0) {
+            required_type = VK_LAYER_SETTING_TYPE_UINT32_EXT;
+        } else if (strcmp(VK_LAYER_SYNCVAL_TELEMETRY_FILENAME, setting.pSettingName) == 0) {
+            required_type = VK_LAYER_SETTING_TYPE_STRING_EXT;
         } else if (strcmp(VK_LAYER_MESSAGE_FORMAT_JSON, setting.pSettingName) == 0) {
             required_type = VK_LAYER_SETTING_TYPE_BOOL32_EXT;
         } else if (strcmp(VK_LAYER_MESSAGE_FORMAT_DISPLAY_APPLICATION_NAME, setting.pSettingName) == 0) {
@@ -1017,6 +1035,10 @@ void ProcessConfigAndEnvSettings(ConfigAndEnvSettings *settings_data) {
         vkuGetLayerSettingValue(layer_setting_set, VK_LAYER_DEBUG_DISABLE_SPIRV_VAL, global_settings.debug_disable_spirv_val);
     }
 
+    if (vkuHasLayerSetting(layer_setting_set, VK_LAYER_CHECK_SHADERS_ASYNC)) {
+        vkuGetLayerSettingValue(layer_setting_set, VK_LAYER_CHECK_SHADERS_ASYNC, global_settings.async_spirv_val);
+    }
+
     if (vkuHasLayerSetting(layer_setting_set, VK_LAYER_CUSTOM_STYPE_LIST)) {
         vkuGetLayerSettingValues(layer_setting_set, VK_LAYER_CUSTOM_STYPE_LIST, GetCustomStypeInfo());
     }
@@ -1223,6 +1245,28 @@ void ProcessConfigAndEnvSettings(ConfigAndEnvSettings *settings_data) {
                                 syncval_settings.message_extra_properties);
     }
 
+    if (vkuHasLayerSetting(layer_setting_set, VK_LAYER_SYNCVAL_MAX_RETAINED_SUBMITS)) {
+        vkuGetLayerSettingValue(layer_setting_set, VK_LAYER_SYNCVAL_MAX_RETAINED_SUBMITS, syncval_settings.max_retained_submits);
+    }
+
+    if (vkuHasLayerSetting(layer_setting_set, VK_LAYER_SYNCVAL_MAX_RETAINED_HISTORY_MB)) {
+        vkuGetLayerSettingValue(layer_setting_set, VK_LAYER_SYNCVAL_MAX_RETAINED_HISTORY_MB,
+                                syncval_settings.max_retained_history_mb);
+    }
+
+    if (vkuHasLayerSetting(layer_setting_set, VK_LAYER_SYNCVAL_TELEMETRY)) {
+        vkuGetLayerSettingValue(layer_setting_set, VK_LAYER_SYNCVAL_TELEMETRY, syncval_settings.telemetry);
+    }
+
+    if (vkuHasLayerSetting(layer_setting_set, VK_LAYER_SYNCVAL_TELEMETRY_REPORT_INTERVAL)) {
+        vkuGetLayerSettingValue(layer_setting_set, VK_LAYER_SYNCVAL_TELEMETRY_REPORT_INTERVAL,
+                                syncval_settings.telemetry_report_interval);
+    }
+
+    if (vkuHasLayerSetting(layer_setting_set, VK_LAYER_SYNCVAL_TELEMETRY_FILENAME)) {
+        vkuGetLayerSettingValue(layer_setting_set, VK_LAYER_SYNCVAL_TELEMETRY_FILENAME, syncval_settings.telemetry_filename);
+    }
+
     const char *REMOVED_VK_LAYER_SYNCVAL_MESSAGE_EXTRA_PROPERTIES_PRETTY_PRINT = "syncval_message_extra_properties_pretty_print";
     if (vkuHasLayerSetting(layer_setting_set, REMOVED_VK_LAYER_SYNCVAL_MESSAGE_EXTRA_PROPERTIES_PRETTY_PRINT)) {
         setting_warnings.emplace_back(std::string(REMOVED_VK_LAYER_SYNCVAL_MESSAGE_EXTRA_PROPERTIES_PRETTY_PRINT) +
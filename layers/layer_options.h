@@ -83,6 +83,8 @@ struct GlobalSettings {
     bool fine_grained_locking = true;
 
     bool debug_disable_spirv_val = false;
+    // Run spirv-val for vkCreateShaderModule on worker threads, errors are reported when the module is first used
+    bool async_spirv_val = false;
 };
 
 class DebugReport;
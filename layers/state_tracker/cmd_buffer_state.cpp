@@ -1092,6 +1092,10 @@ void CommandBuffer::End(VkResult result) {
     if (result == VK_SUCCESS) {
         state = CbState::Recorded;
     }
+
+    for (auto &item : sub_states_) {
+        item.second->End();
+    }
 }
 
 void CommandBuffer::ExecuteCommands(vvl::span<const VkCommandBuffer> secondary_command_buffers) {
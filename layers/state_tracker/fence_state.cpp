@@ -67,6 +67,7 @@ bool vvl::Fence::EnqueueSignal(vvl::Queue *queue_state, uint64_t next_seq) {
 // Called from a non-queue operation, such as vkWaitForFences()|
 void vvl::Fence::NotifyAndWait(const Location &loc) {
     std::shared_future<void> waiter;
+    SubmissionReference signal_submission_ref;
     std::optional<SubmissionReference> present_submission_ref;
     {
         // Hold the lock only while updating members, but not
@@ -74,8 +75,8 @@ void vvl::Fence::NotifyAndWait(const Location &loc) {
         auto guard = WriteLock();
         if (state_ == kInflight) {
             if (queue_) {
-                queue_->Notify(seq_);
                 waiter = waiter_;
+                signal_submission_ref = SubmissionReference(queue_, seq_);
             } else {
                 state_ = kRetired;
                 completed_.set_value();
@@ -94,6 +95,11 @@ void vvl::Fence::NotifyAndWait(const Location &loc) {
         }
         present_wait_semaphores_.clear();
     }
+    if (signal_submission_ref.queue) {
+        // Retire the submission on this thread if the queue is not already being retired elsewhere.
+        // Done without the fence lock, retiring the submission needs it.
+        signal_submission_ref.queue->NotifyAndWait(loc, signal_submission_ref.seq);
+    }
     if (waiter.valid()) {
         auto result = waiter.wait_until(GetCondWaitTimeout());
         if (result != std::future_status::ready) {
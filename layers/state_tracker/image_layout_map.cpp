@@ -24,10 +24,9 @@
 namespace image_layout_map {
 using LayoutEntry = ImageLayoutRegistry::LayoutEntry;
 
-template <typename LayoutsMap>
-static bool UpdateLayoutStateImpl(LayoutsMap& layouts, const IndexRange& range, const LayoutEntry& new_entry) {
-    using CachedLowerBound = typename sparse_container::cached_lower_bound_impl<LayoutsMap>;
-    CachedLowerBound pos(layouts, range.begin);
+template <typename LayoutsMap, typename CachedLowerBound>
+static bool UpdateLayoutRangeImpl(LayoutsMap& layouts, CachedLowerBound& pos, const IndexRange& range,
+                                  const LayoutEntry& new_entry) {
     bool updated_current = false;
     while (range.includes(pos->index)) {
         if (!pos->valid) {
@@ -62,8 +61,46 @@ static bool UpdateLayoutStateImpl(LayoutsMap& layouts, const IndexRange& range,
     return updated_current;
 }
 
+// Updates every generated range in a single forward walk of the map. The ranges are sorted, so between ranges the cached
+// lower bound usually only has to step to the next entry instead of searching the whole map again.
+template <typename LayoutsMap, typename RangeGen>
+static bool UpdateLayoutStateImpl(LayoutsMap& layouts, RangeGen& range_gen, const LayoutEntry& new_entry) {
+    if (!range_gen->non_empty()) {
+        return false;
+    }
+    using CachedLowerBound = typename sparse_container::cached_lower_bound_impl<LayoutsMap>;
+    CachedLowerBound pos(layouts, range_gen->begin);
+    bool updated_current = false;
+    for (; range_gen->non_empty(); ++range_gen) {
+        const IndexRange range = *range_gen;
+        pos.seek(range.begin);
+        updated_current |= UpdateLayoutRangeImpl(layouts, pos, range, new_entry);
+    }
+    return updated_current;
+}
+
+// Images with a single subresource only ever have the [0, 1) entry, which lives inline in the small map, so it is
+// updated in place without generating ranges or seeking through the map.
+template <typename LayoutsMap>
+static bool UpdateSingleLayoutState(LayoutsMap& layouts, const LayoutEntry& new_entry) {
+    auto it = layouts.begin();
+    if (it == layouts.end()) {
+        layouts.insert(it, std::make_pair(IndexRange(0, 1), new_entry));
+        return true;
+    }
+    return it->second.Update(new_entry);
+}
+
+static bool CoversSingleSubresource(const VkImageSubresourceRange& range) {
+    // The range is already known to be in range, so it can only start at the first mip and layer
+    return range.levelCount != 0 && range.layerCount != 0;
+}
+
 ImageLayoutRegistry::ImageLayoutRegistry(const vvl::Image& image_state)
-    : image_state_(image_state), encoder_(image_state.subresource_encoder), layout_map_(encoder_.SubresourceCount()) {}
+    : image_state_(image_state),
+      encoder_(image_state.subresource_encoder),
+      layout_map_(encoder_.SubresourceCount()),
+      single_subresource_(encoder_.SubresourceCount() == 1) {}
 
 bool ImageLayoutRegistry::SetSubresourceRangeLayout(const VkImageSubresourceRange& range, VkImageLayout layout,
                                                     VkImageLayout expected_layout) {
@@ -71,21 +108,17 @@ bool ImageLayoutRegistry::SetSubresourceRangeLayout(const VkImageSubresourceRang
         return false;  // Don't even try to track bogus subresources
     }
 
-    RangeGenerator range_gen(encoder_, range);
+    validated_version_.store(0, std::memory_order_relaxed);
     const LayoutEntry entry = LayoutEntry::ForCurrentLayout(layout, expected_layout);
-    bool updated = false;
+    if (single_subresource_) {
+        return CoversSingleSubresource(range) && UpdateSingleLayoutState(layout_map_.GetSmallMap(), entry);
+    }
+    RangeGenerator range_gen(encoder_, range);
     if (layout_map_.UsesSmallMap()) {
-        auto& layout_map = layout_map_.GetSmallMap();
-        for (; range_gen->non_empty(); ++range_gen) {
-            updated |= UpdateLayoutStateImpl(layout_map, *range_gen, entry);
-        }
+        return UpdateLayoutStateImpl(layout_map_.GetSmallMap(), range_gen, entry);
     } else {
-        auto& layout_map = layout_map_.GetBigMap();
-        for (; range_gen->non_empty(); ++range_gen) {
-            updated |= UpdateLayoutStateImpl(layout_map, *range_gen, entry);
-        }
+        return UpdateLayoutStateImpl(layout_map_.GetBigMap(), range_gen, entry);
     }
-    return updated;
 }
 
 // Unwrap the BothMaps entry here as this is a performance hotspot.
@@ -94,35 +127,40 @@ void ImageLayoutRegistry::SetSubresourceRangeInitialLayout(const VkImageSubresou
         return;  // Don't even try to track bogus subreources
     }
 
-    RangeGenerator range_gen(encoder_, range);
+    validated_version_.store(0, std::memory_order_relaxed);
     const LayoutEntry entry = LayoutEntry::ForExpectedLayout(layout);
+    if (single_subresource_) {
+        if (CoversSingleSubresource(range)) {
+            UpdateSingleLayoutState(layout_map_.GetSmallMap(), entry);
+        }
+        return;
+    }
+    RangeGenerator range_gen(encoder_, range);
     if (layout_map_.UsesSmallMap()) {
         auto& layout_map = layout_map_.GetSmallMap();
-        for (; range_gen->non_empty(); ++range_gen) {
-            UpdateLayoutStateImpl(layout_map, *range_gen, entry);
-        }
+        UpdateLayoutStateImpl(layout_map, range_gen, entry);
     } else {
         auto& layout_map = layout_map_.GetBigMap();
-        for (; range_gen->non_empty(); ++range_gen) {
-            UpdateLayoutStateImpl(layout_map, *range_gen, entry);
-        }
+        UpdateLayoutStateImpl(layout_map, range_gen, entry);
     }
 }
 
 // Unwrap the BothMaps entry here as this is a performance hotspot.
 void ImageLayoutRegistry::SetSubresourceRangeInitialLayout(VkImageLayout layout, const vvl::ImageView& view_state) {
-    RangeGenerator range_gen(view_state.range_generator);
+    validated_version_.store(0, std::memory_order_relaxed);
     const LayoutEntry entry = LayoutEntry::ForExpectedLayout(layout, view_state.normalized_subresource_range.aspectMask);
+    if (single_subresource_) {
+        // A view of a single subresource image always covers that subresource
+        UpdateSingleLayoutState(layout_map_.GetSmallMap(), entry);
+        return;
+    }
+    RangeGenerator range_gen(view_state.range_generator);
     if (layout_map_.UsesSmallMap()) {
         auto& layout_map = layout_map_.GetSmallMap();
-        for (; range_gen->non_empty(); ++range_gen) {
-            UpdateLayoutStateImpl(layout_map, *range_gen, entry);
-        }
+        UpdateLayoutStateImpl(layout_map, range_gen, entry);
     } else {
         auto& layout_map = layout_map_.GetBigMap();
-        for (; range_gen->non_empty(); ++range_gen) {
-            UpdateLayoutStateImpl(layout_map, *range_gen, entry);
-        }
+        UpdateLayoutStateImpl(layout_map, range_gen, entry);
     }
 }
 
@@ -139,6 +177,7 @@ bool ImageLayoutRegistry::UpdateFrom(const ImageLayoutRegistry& other) {
     if (CompatibilityKey() != other.CompatibilityKey()) {
         return false;
     }
+    validated_version_.store(0, std::memory_order_relaxed);
     return sparse_container::splice(layout_map_, other.layout_map_, LayoutEntry::Updater());
 }
 
@@ -174,6 +213,11 @@ bool ImageLayoutRegistry::LayoutEntry::Update(const LayoutEntry& src) {
 
 }  // namespace image_layout_map
 
+uint64_t ImageLayoutRangeMap::NextVersion() {
+    static std::atomic<uint64_t> next_version{1};
+    return next_version.fetch_add(1, std::memory_order_relaxed);
+}
+
 bool ImageLayoutRangeMap::AnyInRange(RangeGenerator& gen,
                                      std::function<bool(const key_type& range, const mapped_type& state)>&& func) const {
     for (; gen->non_empty(); ++gen) {
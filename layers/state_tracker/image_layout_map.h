@@ -20,6 +20,8 @@
  */
 #pragma once
 
+#include <atomic>
+#include <cassert>
 #include <functional>
 
 #include "containers/range.h"
@@ -93,6 +95,11 @@ class ImageLayoutRegistry {
     ~ImageLayoutRegistry() {}
     uint32_t GetImageId() const;
 
+    // Version of the image layout map that this registry was last validated against at submit time without finding a layout
+    // mismatch (zero if none). Any change to the registry clears it, so a matching version means validation would pass again.
+    uint64_t ValidatedVersion() const { return validated_version_.load(std::memory_order_relaxed); }
+    void SetValidatedVersion(uint64_t version) const { validated_version_.store(version, std::memory_order_relaxed); }
+
     // This looks a bit ponderous but kAspectCount is a compile time constant
     VkImageSubresource Decode(IndexType index) const {
         const auto subres = encoder_.Decode(index);
@@ -135,6 +142,9 @@ class ImageLayoutRegistry {
     const vvl::Image& image_state_;
     const Encoder& encoder_;
     LayoutMap layout_map_;
+    // Single mip, layer and aspect images (render targets, UI textures) bypass range generation when recording layouts
+    const bool single_subresource_;
+    mutable std::atomic<uint64_t> validated_version_{0};
 };
 }  // namespace image_layout_map
 
@@ -148,9 +158,22 @@ class ImageLayoutRangeMap : public subresource_adapter::BothRangeMap<VkImageLayo
 
     bool AnyInRange(RangeGenerator& gen, std::function<bool(const key_type& range, const mapped_type& state)>&& func) const;
 
+    // Only the layout maps owned by an image are versioned, the others stay at zero. The version changes whenever the layouts
+    // in the map change and is unique across all maps, so a version recorded for one map never matches a different map.
+    // Accessed under the map lock.
+    uint64_t Version() const { return version_; }
+    void BumpVersion() {
+        assert(lock);
+        version_ = NextVersion();
+    }
+
     // Not null if this layout map is owned by the vvl::Image and points to vvl::Image::layout_range_map_lock.
     // The layout maps that are not owned by the images do not use locking functionality.
     std::shared_mutex* lock = nullptr;
+
+  private:
+    static uint64_t NextVersion();
+    uint64_t version_ = 0;
 };
 
 using SubmissionImageLayoutMap = vvl::unordered_map<const vvl::Image*, std::optional<ImageLayoutRangeMap>>;
@@ -379,6 +379,7 @@ void Image::SetInitialLayoutMap() {
         // set up the new map completely before making it available
         layout_map = std::make_shared<ImageLayoutRangeMap>(subresource_encoder.SubresourceCount());
         layout_map->lock = &layout_range_map_lock;
+        layout_map->BumpVersion();
         auto range_gen = subresource_adapter::RangeGenerator(subresource_encoder);
         for (; range_gen->non_empty(); ++range_gen) {
             layout_map->insert(layout_map->end(), std::make_pair(*range_gen, create_info.initialLayout));
@@ -396,6 +397,7 @@ void Image::SetImageLayout(const VkImageSubresourceRange &range, VkImageLayout l
     for (; range_gen->non_empty(); ++range_gen) {
         update_range_value(*layout_range_map, *range_gen, layout, value_precedence::prefer_source);
     }
+    layout_range_map->BumpVersion();
 }
 
 void Image::SetSwapchain(std::shared_ptr<vvl::Swapchain> &swapchain, uint32_t swapchain_index) {
@@ -221,8 +221,8 @@ class Image : public Bindable, public SubStateManager<ImageSubState> {
     template <typename UnaryPredicate>
     bool AnyAliasBindingOf(const StateObject::NodeMap &bindings, const UnaryPredicate &pred) const {
         for (auto &entry : bindings) {
-            if (entry.first.type == kVulkanObjectTypeImage) {
-                auto state_object = entry.second.lock();
+            if (entry.handle.type == kVulkanObjectTypeImage) {
+                auto state_object = entry.node.lock();
                 if (state_object) {
                     auto other_image = static_cast<Image *>(state_object.get());
                     if ((other_image != this) && other_image->IsCompatibleAliasing(this)) {
@@ -369,8 +369,8 @@ class Pipeline : public StateObject {
     }
 
     const FragmentOutputState::AttachmentStateVector &AttachmentStates() const {
-        if (fragment_output_state) {
-            return fragment_output_state->attachment_states;
+        if (fragment_output_state && fragment_output_state->attachment_states) {
+            return *fragment_output_state->attachment_states;
         }
         static FragmentOutputState::AttachmentStateVector empty_vec = {};
         return empty_vec;
@@ -18,6 +18,9 @@
 #include "state_tracker/pipeline_sub_state.h"
 #include "state_tracker/pipeline_state.h"
 #include "state_tracker/shader_module.h"
+#include "utils/hash_util.h"
+
+#include <cstring>
 
 bool PipelineSubState::IsIndependentSets() const {
     if (const auto layout_state = parent.PipelineLayoutState()) {
@@ -163,32 +166,202 @@ PreRasterState::PreRasterState(const vvl::Pipeline &p, const vvl::DeviceState &s
     }
 }
 
-std::unique_ptr<const vku::safe_VkPipelineColorBlendStateCreateInfo> ToSafeColorBlendState(
-    const vku::safe_VkPipelineColorBlendStateCreateInfo &cbs) {
-    // This is needlessly copied here. Might better to make this a plain pointer, with an optional "backing unique_ptr"
-    return std::make_unique<const vku::safe_VkPipelineColorBlendStateCreateInfo>(cbs);
+namespace {
+// Floats are compared bitwise so that hash and equality always agree (-0.0 vs 0.0, NaN)
+uint32_t FloatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
 }
-std::unique_ptr<const vku::safe_VkPipelineColorBlendStateCreateInfo> ToSafeColorBlendState(
-    const VkPipelineColorBlendStateCreateInfo &cbs) {
-    return std::make_unique<const vku::safe_VkPipelineColorBlendStateCreateInfo>(&cbs);
+
+void HashColorBlendAttachments(hash_util::HashCombiner &hc, const VkPipelineColorBlendAttachmentState *attachments,
+                               uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto &a = attachments[i];
+        hc << a.blendEnable << a.srcColorBlendFactor << a.dstColorBlendFactor << a.colorBlendOp << a.srcAlphaBlendFactor
+           << a.dstAlphaBlendFactor << a.alphaBlendOp << a.colorWriteMask;
+    }
 }
-std::unique_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ToSafeMultisampleState(
-    const vku::safe_VkPipelineMultisampleStateCreateInfo &cbs) {
-    // This is needlessly copied here. Might better to make this a plain pointer, with an optional "backing unique_ptr"
-    return std::make_unique<const vku::safe_VkPipelineMultisampleStateCreateInfo>(cbs);
+
+// The hash and equality functors take both the canonical (safe) structs and the structs passed by the application, so the
+// dictionaries can look the application's state up without copying it first.
+struct ColorBlendAttachmentsRef {
+    const VkPipelineColorBlendAttachmentState *data;
+    uint32_t count;
+};
+ColorBlendAttachmentsRef MakeRef(const ColorBlendAttachmentsRef &ref) { return ref; }
+ColorBlendAttachmentsRef MakeRef(const std::vector<VkPipelineColorBlendAttachmentState> &attachments) {
+    return {attachments.data(), static_cast<uint32_t>(attachments.size())};
 }
-std::unique_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ToSafeMultisampleState(
-    const VkPipelineMultisampleStateCreateInfo &cbs) {
-    return std::make_unique<const vku::safe_VkPipelineMultisampleStateCreateInfo>(&cbs);
+
+struct ColorBlendAttachmentsHash {
+    template <typename Attachments>
+    size_t operator()(const Attachments &attachments) const {
+        const ColorBlendAttachmentsRef ref = MakeRef(attachments);
+        hash_util::HashCombiner hc;
+        HashColorBlendAttachments(hc, ref.data, ref.count);
+        return hc.Value();
+    }
+};
+
+struct ColorBlendAttachmentsEqual {
+    template <typename Lhs, typename Rhs>
+    bool operator()(const Lhs &lhs_attachments, const Rhs &rhs_attachments) const {
+        const ColorBlendAttachmentsRef lhs = MakeRef(lhs_attachments);
+        const ColorBlendAttachmentsRef rhs = MakeRef(rhs_attachments);
+        // VkPipelineColorBlendAttachmentState is made only of 32-bit members, so there is no padding to worry about
+        return lhs.count == rhs.count &&
+               (lhs.count == 0 || std::memcmp(lhs.data, rhs.data, lhs.count * sizeof(VkPipelineColorBlendAttachmentState)) == 0);
+    }
+};
+
+struct ColorBlendStateHash {
+    template <typename ColorBlendState>
+    size_t operator()(const ColorBlendState &cbs) const {
+        hash_util::HashCombiner hc;
+        hc << cbs.flags << cbs.logicOpEnable << cbs.logicOp << cbs.attachmentCount << (cbs.pAttachments != nullptr);
+        for (float constant : cbs.blendConstants) {
+            hc << FloatBits(constant);
+        }
+        if (cbs.pAttachments) {
+            HashColorBlendAttachments(hc, cbs.pAttachments, cbs.attachmentCount);
+        }
+        return hc.Value();
+    }
+};
+
+struct ColorBlendStateEqual {
+    template <typename Lhs, typename Rhs>
+    bool operator()(const Lhs &lhs, const Rhs &rhs) const {
+        if (lhs.flags != rhs.flags || lhs.logicOpEnable != rhs.logicOpEnable || lhs.logicOp != rhs.logicOp ||
+            lhs.attachmentCount != rhs.attachmentCount || !hash_util::SimilarForNullity(lhs.pAttachments, rhs.pAttachments)) {
+            return false;
+        }
+        for (uint32_t i = 0; i < 4; ++i) {
+            if (FloatBits(lhs.blendConstants[i]) != FloatBits(rhs.blendConstants[i])) {
+                return false;
+            }
+        }
+        return !lhs.pAttachments || lhs.attachmentCount == 0 ||
+               std::memcmp(lhs.pAttachments, rhs.pAttachments, lhs.attachmentCount * sizeof(VkPipelineColorBlendAttachmentState)) == 0;
+    }
+};
+
+template <typename MultisampleState>
+uint32_t SampleMaskWordCount(const MultisampleState &ms) {
+    return ms.pSampleMask ? (static_cast<uint32_t>(ms.rasterizationSamples) + 31) / 32 : 0;
 }
-std::unique_ptr<const vku::safe_VkPipelineDepthStencilStateCreateInfo> ToSafeDepthStencilState(
-    const vku::safe_VkPipelineDepthStencilStateCreateInfo &cbs) {
-    // This is needlessly copied here. Might better to make this a plain pointer, with an optional "backing unique_ptr"
-    return std::make_unique<const vku::safe_VkPipelineDepthStencilStateCreateInfo>(cbs);
+
+struct MultisampleStateHash {
+    template <typename MultisampleState>
+    size_t operator()(const MultisampleState &ms) const {
+        hash_util::HashCombiner hc;
+        hc << ms.flags << ms.rasterizationSamples << ms.sampleShadingEnable << FloatBits(ms.minSampleShading)
+           << ms.alphaToCoverageEnable << ms.alphaToOneEnable << (ms.pSampleMask != nullptr);
+        hc.Combine(ms.pSampleMask, ms.pSampleMask + SampleMaskWordCount(ms));
+        return hc.Value();
+    }
+};
+
+struct MultisampleStateEqual {
+    template <typename Lhs, typename Rhs>
+    bool operator()(const Lhs &lhs, const Rhs &rhs) const {
+        if (lhs.flags != rhs.flags || lhs.rasterizationSamples != rhs.rasterizationSamples ||
+            lhs.sampleShadingEnable != rhs.sampleShadingEnable || FloatBits(lhs.minSampleShading) != FloatBits(rhs.minSampleShading) ||
+            lhs.alphaToCoverageEnable != rhs.alphaToCoverageEnable || lhs.alphaToOneEnable != rhs.alphaToOneEnable ||
+            !hash_util::SimilarForNullity(lhs.pSampleMask, rhs.pSampleMask)) {
+            return false;
+        }
+        const uint32_t mask_words = SampleMaskWordCount(lhs);
+        return mask_words == 0 || std::memcmp(lhs.pSampleMask, rhs.pSampleMask, mask_words * sizeof(VkSampleMask)) == 0;
+    }
+};
+
+void HashStencilOpState(hash_util::HashCombiner &hc, const VkStencilOpState &op) {
+    hc << op.failOp << op.passOp << op.depthFailOp << op.compareOp << op.compareMask << op.writeMask << op.reference;
+}
+
+struct DepthStencilStateHash {
+    template <typename DepthStencilState>
+    size_t operator()(const DepthStencilState &ds) const {
+        hash_util::HashCombiner hc;
+        hc << ds.flags << ds.depthTestEnable << ds.depthWriteEnable << ds.depthCompareOp << ds.depthBoundsTestEnable
+           << ds.stencilTestEnable << FloatBits(ds.minDepthBounds) << FloatBits(ds.maxDepthBounds);
+        HashStencilOpState(hc, ds.front);
+        HashStencilOpState(hc, ds.back);
+        return hc.Value();
+    }
+};
+
+struct DepthStencilStateEqual {
+    template <typename Lhs, typename Rhs>
+    bool operator()(const Lhs &lhs, const Rhs &rhs) const {
+        // VkStencilOpState is made only of 32-bit members, so there is no padding to worry about
+        return lhs.flags == rhs.flags && lhs.depthTestEnable == rhs.depthTestEnable && lhs.depthWriteEnable == rhs.depthWriteEnable &&
+               lhs.depthCompareOp == rhs.depthCompareOp && lhs.depthBoundsTestEnable == rhs.depthBoundsTestEnable &&
+               lhs.stencilTestEnable == rhs.stencilTestEnable && FloatBits(lhs.minDepthBounds) == FloatBits(rhs.minDepthBounds) &&
+               FloatBits(lhs.maxDepthBounds) == FloatBits(rhs.maxDepthBounds) &&
+               std::memcmp(&lhs.front, &rhs.front, sizeof(VkStencilOpState)) == 0 &&
+               std::memcmp(&lhs.back, &rhs.back, sizeof(VkStencilOpState)) == 0;
+    }
+};
+
+using ColorBlendAttachmentsDict = hash_util::WeakDictionary<std::vector<VkPipelineColorBlendAttachmentState>,
+                                                            ColorBlendAttachmentsHash, ColorBlendAttachmentsEqual>;
+using ColorBlendStateDict =
+    hash_util::WeakDictionary<vku::safe_VkPipelineColorBlendStateCreateInfo, ColorBlendStateHash, ColorBlendStateEqual>;
+using MultisampleStateDict =
+    hash_util::WeakDictionary<vku::safe_VkPipelineMultisampleStateCreateInfo, MultisampleStateHash, MultisampleStateEqual>;
+using DepthStencilStateDict =
+    hash_util::WeakDictionary<vku::safe_VkPipelineDepthStencilStateCreateInfo, DepthStencilStateHash, DepthStencilStateEqual>;
+}  // namespace
+
+// Dictionaries of the canonical form of the fixed function blocks shared between pipelines. Entries are released with the
+// last pipeline using them.
+static ColorBlendAttachmentsDict color_blend_attachments_dict;
+static ColorBlendStateDict color_blend_state_dict;
+static MultisampleStateDict multisample_state_dict;
+static DepthStencilStateDict depth_stencil_state_dict;
+
+ColorBlendStateId ToSafeColorBlendState(const vku::safe_VkPipelineColorBlendStateCreateInfo &cbs) {
+    if (cbs.pNext) {
+        return std::make_shared<const vku::safe_VkPipelineColorBlendStateCreateInfo>(cbs);
+    }
+    return color_blend_state_dict.LookUp(cbs, cbs);
+}
+ColorBlendStateId ToSafeColorBlendState(const VkPipelineColorBlendStateCreateInfo &cbs) {
+    if (cbs.pNext) {
+        return std::make_shared<const vku::safe_VkPipelineColorBlendStateCreateInfo>(&cbs);
+    }
+    return color_blend_state_dict.LookUp(cbs, &cbs);
+}
+MultisampleStateId ToSafeMultisampleState(const vku::safe_VkPipelineMultisampleStateCreateInfo &cbs) {
+    if (cbs.pNext) {
+        return std::make_shared<const vku::safe_VkPipelineMultisampleStateCreateInfo>(cbs);
+    }
+    return multisample_state_dict.LookUp(cbs, cbs);
+}
+MultisampleStateId ToSafeMultisampleState(const VkPipelineMultisampleStateCreateInfo &cbs) {
+    if (cbs.pNext) {
+        return std::make_shared<const vku::safe_VkPipelineMultisampleStateCreateInfo>(&cbs);
+    }
+    return multisample_state_dict.LookUp(cbs, &cbs);
+}
+DepthStencilStateId ToSafeDepthStencilState(const vku::safe_VkPipelineDepthStencilStateCreateInfo &cbs) {
+    if (cbs.pNext) {
+        return std::make_shared<const vku::safe_VkPipelineDepthStencilStateCreateInfo>(cbs);
+    }
+    return depth_stencil_state_dict.LookUp(cbs, cbs);
+}
+DepthStencilStateId ToSafeDepthStencilState(const VkPipelineDepthStencilStateCreateInfo &cbs) {
+    if (cbs.pNext) {
+        return std::make_shared<const vku::safe_VkPipelineDepthStencilStateCreateInfo>(&cbs);
+    }
+    return depth_stencil_state_dict.LookUp(cbs, &cbs);
 }
-std::unique_ptr<const vku::safe_VkPipelineDepthStencilStateCreateInfo> ToSafeDepthStencilState(
-    const VkPipelineDepthStencilStateCreateInfo &cbs) {
-    return std::make_unique<const vku::safe_VkPipelineDepthStencilStateCreateInfo>(&cbs);
+ColorBlendAttachmentsId GetCanonicalId(uint32_t attachment_count, const VkPipelineColorBlendAttachmentState *attachments) {
+    return color_blend_attachments_dict.LookUp(ColorBlendAttachmentsRef{attachments, attachment_count}, attachments,
+                                               attachments + attachment_count);
 }
 std::unique_ptr<const vku::safe_VkPipelineShaderStageCreateInfo> ToShaderStageCI(
     const vku::safe_VkPipelineShaderStageCreateInfo &cbs) {
@@ -125,18 +125,21 @@ struct PreRasterState : public PipelineSubState {
                                                    *task_shader_ci = nullptr, *mesh_shader_ci = nullptr;
 };
 
-std::unique_ptr<const vku::safe_VkPipelineColorBlendStateCreateInfo> ToSafeColorBlendState(
-    const vku::safe_VkPipelineColorBlendStateCreateInfo &cbs);
-std::unique_ptr<const vku::safe_VkPipelineColorBlendStateCreateInfo> ToSafeColorBlendState(
-    const VkPipelineColorBlendStateCreateInfo &cbs);
-std::unique_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ToSafeMultisampleState(
-    const vku::safe_VkPipelineMultisampleStateCreateInfo &cbs);
-std::unique_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ToSafeMultisampleState(
-    const VkPipelineMultisampleStateCreateInfo &cbs);
-std::unique_ptr<const vku::safe_VkPipelineDepthStencilStateCreateInfo> ToSafeDepthStencilState(
-    const vku::safe_VkPipelineDepthStencilStateCreateInfo &cbs);
-std::unique_ptr<const vku::safe_VkPipelineDepthStencilStateCreateInfo> ToSafeDepthStencilState(
-    const VkPipelineDepthStencilStateCreateInfo &cbs);
+// The color blend, multisample and depth/stencil blocks are hash-consed: PSO permutations that share an identical block
+// (without a pNext chain) share a single canonical copy, the same way DescriptorSetLayoutDef is deduplicated.
+// Blocks extended by a pNext chain are not compared and always get a private copy.
+using ColorBlendStateId = std::shared_ptr<const vku::safe_VkPipelineColorBlendStateCreateInfo>;
+using MultisampleStateId = std::shared_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo>;
+using DepthStencilStateId = std::shared_ptr<const vku::safe_VkPipelineDepthStencilStateCreateInfo>;
+using ColorBlendAttachmentsId = std::shared_ptr<const std::vector<VkPipelineColorBlendAttachmentState>>;
+
+ColorBlendStateId ToSafeColorBlendState(const vku::safe_VkPipelineColorBlendStateCreateInfo &cbs);
+ColorBlendStateId ToSafeColorBlendState(const VkPipelineColorBlendStateCreateInfo &cbs);
+MultisampleStateId ToSafeMultisampleState(const vku::safe_VkPipelineMultisampleStateCreateInfo &cbs);
+MultisampleStateId ToSafeMultisampleState(const VkPipelineMultisampleStateCreateInfo &cbs);
+DepthStencilStateId ToSafeDepthStencilState(const vku::safe_VkPipelineDepthStencilStateCreateInfo &cbs);
+DepthStencilStateId ToSafeDepthStencilState(const VkPipelineDepthStencilStateCreateInfo &cbs);
+ColorBlendAttachmentsId GetCanonicalId(uint32_t attachment_count, const VkPipelineColorBlendAttachmentState *attachments);
 std::unique_ptr<const vku::safe_VkPipelineShaderStageCreateInfo> ToShaderStageCI(
     const vku::safe_VkPipelineShaderStageCreateInfo &cbs);
 std::unique_ptr<const vku::safe_VkPipelineShaderStageCreateInfo> ToShaderStageCI(const VkPipelineShaderStageCreateInfo &cbs);
@@ -164,8 +167,8 @@ struct FragmentShaderState : public PipelineSubState {
     uint32_t subpass = 0;
 
     std::shared_ptr<const vvl::PipelineLayout> pipeline_layout;
-    std::unique_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ms_state;
-    std::unique_ptr<const vku::safe_VkPipelineDepthStencilStateCreateInfo> ds_state;
+    MultisampleStateId ms_state;
+    DepthStencilStateId ds_state;
 
     std::shared_ptr<const vvl::ShaderModule> fragment_shader;
     std::unique_ptr<const vku::safe_VkPipelineShaderStageCreateInfo> fragment_shader_ci;
@@ -210,10 +213,9 @@ struct FragmentOutputState : public PipelineSubState {
             // In case of being dynamic state
             if (cbci.pAttachments) {
                 if (cbci.attachmentCount) {
-                    attachment_states.reserve(cbci.attachmentCount);
-                    std::copy(cbci.pAttachments, cbci.pAttachments + cbci.attachmentCount, std::back_inserter(attachment_states));
+                    attachment_states = GetCanonicalId(cbci.attachmentCount, cbci.pAttachments);
+                    blend_constants_enabled = IsBlendConstantsEnabled(*attachment_states);
                 }
-                blend_constants_enabled = IsBlendConstantsEnabled(attachment_states);
             }
         }
 
@@ -236,10 +238,11 @@ struct FragmentOutputState : public PipelineSubState {
     std::shared_ptr<const vvl::RenderPass> rp_state;
     uint32_t subpass = 0;
 
-    std::unique_ptr<const vku::safe_VkPipelineColorBlendStateCreateInfo> color_blend_state;
-    std::unique_ptr<const vku::safe_VkPipelineMultisampleStateCreateInfo> ms_state;
+    ColorBlendStateId color_blend_state;
+    MultisampleStateId ms_state;
 
-    AttachmentStateVector attachment_states;
+    // null if there are no attachments (or they are dynamic)
+    ColorBlendAttachmentsId attachment_states;
 
     bool legacy_dithering_enabled = false;
     bool blend_constants_enabled = false;  // Blend constants enabled for any attachments
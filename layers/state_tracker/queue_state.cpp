@@ -26,6 +26,8 @@
 
 #include "profiling/profiling.h"
 
+#include <algorithm>
+
 void vvl::QueueSubmission::BeginUse() {
     for (SemaphoreInfo &wait : wait_semaphores) {
         wait.semaphore->BeginUse();
@@ -97,38 +99,51 @@ vvl::PreSubmitResult vvl::Queue::PreSubmit(std::vector<vvl::QueueSubmission> &&s
         {
             auto guard = Lock();
             submissions_.emplace_back(std::move(submission));
-            if (!thread_) {
-                thread_ = std::make_unique<std::thread>(&Queue::ThreadFunc, this);
-            }
         }
     }
     return result;
 }
 
 void vvl::Queue::Notify(uint64_t until_seq) {
-    auto guard = Lock();
-    if (until_seq == kU64Max) {
-        until_seq = seq_.load();
+    bool post_retire = false;
+    {
+        auto guard = Lock();
+        if (until_seq == kU64Max) {
+            until_seq = seq_.load();
+        }
+        if (request_seq_ < until_seq) {
+            request_seq_ = until_seq;
+        }
+        post_retire = ScheduleRetire();
     }
-    if (request_seq_ < until_seq) {
-        request_seq_ = until_seq;
+    // Notify() is called with semaphore and fence locks held, retirement needs those so it can't run inline here
+    if (post_retire) {
+        dev_data_.thread_pool.Post([this]() { RetireTask(); });
     }
-    cond_.notify_one();
 }
 
 void vvl::Queue::Wait(const Location &loc, uint64_t until_seq) {
+    if (until_seq == kU64Max) {
+        until_seq = seq_.load();
+    }
+    if (retired_seq_.load(std::memory_order_acquire) >= until_seq) {
+        return;
+    }
     std::shared_future<void> waiter;
     {
         auto guard = Lock();
-        if (until_seq == kU64Max) {
-            until_seq = seq_.load();
-        }
         if (submissions_.empty() || until_seq < submissions_.begin()->seq) {
             return;
         }
         uint64_t index = until_seq - submissions_.begin()->seq;
         assert(index < submissions_.size());
         waiter = submissions_[static_cast<size_t>(index)].waiter;
+
+        // Rather than waiting for a thread pool worker to get to it, do the work here
+        if (!retiring_ && !exit_) {
+            retiring_ = true;
+            RetireSubmissions(guard, until_seq);
+        }
     }
     auto wait_status = waiter.wait_until(GetCondWaitTimeout());
     if (wait_status != std::future_status::ready) {
@@ -141,7 +156,19 @@ void vvl::Queue::Wait(const Location &loc, uint64_t until_seq) {
 }
 
 void vvl::Queue::NotifyAndWait(const Location &loc, uint64_t until_seq) {
-    Notify(until_seq);
+    if (until_seq == kU64Max) {
+        until_seq = seq_.load();
+    }
+    if (retired_seq_.load(std::memory_order_acquire) >= until_seq) {
+        return;
+    }
+    {
+        auto guard = Lock();
+        if (request_seq_ < until_seq) {
+            request_seq_ = until_seq;
+        }
+    }
+    // Wait() retires on this thread if it can, or else whoever is retiring picks up the new request before stopping
     Wait(loc, until_seq);
 }
 
@@ -151,14 +178,8 @@ std::optional<vvl::SemaphoreInfo> vvl::Queue::FindTimelineWaitWithoutResolvingSi
     // binary semaphores are used this will return immediately.
     uint32_t processed_waits = 0;
 
-    // Run algorithm in two separate steps to avoid lock-inversion with Semaphore::RetireWait:
-    // Semaphore::RetireWait()
-    //     Semaphore::WriteLock()
-    //         Semaphore::CanRetireTimelineWait
-    //             TimePoint::Notify
-    //                  Queue::Lock() <-- semaphore lock is still held here
-    //
-    // Current function:
+    // Run algorithm in two separate steps so the queue lock is never held while locking a semaphore
+    // (semaphore code is allowed to call into queues):
     //     Queue::Lock()
     //     queue lock is released here, can't lock-inverse now
     //     Semaphore::ReadLock()
@@ -235,16 +256,11 @@ void vvl::Queue::UpdatePresentOnlyQueueProgress(const DeviceState &device_state)
 }
 
 void vvl::Queue::Destroy() {
-    std::unique_ptr<std::thread> dead_thread;
     {
         auto guard = Lock();
-        exit_thread_ = true;
-        cond_.notify_all();
-        dead_thread = std::move(thread_);
-    }
-    if (dead_thread && dead_thread->joinable()) {
-        dead_thread->join();
-        dead_thread.reset();
+        exit_ = true;
+        // A posted RetireTask references this queue, wait until it has started and seen exit_
+        idle_cond_.wait(guard, [this]() { return !retiring_ && !retire_posted_; });
     }
     for (auto &item : sub_states_) {
         item.second->Destroy();
@@ -272,21 +288,60 @@ void vvl::Queue::PostSubmit(QueueSubmission &submission) {
     }
 }
 
-vvl::QueueSubmission *vvl::Queue::NextSubmission() {
-    QueueSubmission *result = nullptr;
-    // Find if the next submission is ready so that the thread function doesn't need to worry
-    // about locking.
-    auto guard = Lock();
-    while (!exit_thread_ && (submissions_.empty() || request_seq_ < submissions_.front().seq)) {
-        // The queue thread must wait forever if nothing is happening, until we tell it to exit
-        cond_.wait(guard);
+bool vvl::Queue::HasReadySubmission(uint64_t until_seq) const {
+    return !exit_ && !submissions_.empty() && submissions_.front().seq <= std::min(request_seq_, until_seq);
+}
+
+bool vvl::Queue::ScheduleRetire() {
+    // Whoever is retiring already checks for new work before it stops
+    if (retiring_ || retire_posted_ || !HasReadySubmission(kU64Max)) {
+        return false;
     }
-    if (!exit_thread_) {
-        result = &submissions_.front();
+    retire_posted_ = true;
+    return true;
+}
+
+void vvl::Queue::RetireTask() {
+    VVL_ZoneScoped;
+    auto guard = Lock();
+    retire_posted_ = false;
+    if (retiring_) {
+        // A waiting thread got here first and will repost if it leaves anything behind
+        idle_cond_.notify_all();
+        return;
+    }
+    retiring_ = true;
+    RetireSubmissions(guard, kU64Max);
+}
+
+void vvl::Queue::RetireSubmissions(LockGuard &guard, uint64_t until_seq) {
+    assert(retiring_);
+    // Roll this queue forward, retiring everything that is ready before giving up the thread.
+    while (HasReadySubmission(until_seq)) {
         // NOTE: the submission must remain on the dequeue until we're done processing it so that
-        // anyone waiting for it can find the correct waiter
+        // anyone waiting for it can find the correct waiter. References into a deque stay valid
+        // when new submissions are added to the back.
+        QueueSubmission &submission = submissions_.front();
+        guard.unlock();
+        Retire(submission);
+        guard.lock();
+        // wake up anyone waiting for this submission to be retired
+        std::promise<void> completed = std::move(submission.completed);
+        retired_seq_.store(submission.seq, std::memory_order_release);
+        submissions_.pop_front();
+        guard.unlock();
+        completed.set_value();
+        guard.lock();
+    }
+    retiring_ = false;
+    // Only reached with until_seq limiting the work when helping out in Wait(), hand the rest back to the pool
+    const bool post_retire = ScheduleRetire();
+    idle_cond_.notify_all();
+    if (post_retire) {
+        guard.unlock();
+        dev_data_.thread_pool.Post([this]() { RetireTask(); });
+        guard.lock();
     }
-    return result;
 }
 
 void vvl::Queue::Retire(QueueSubmission &submission) {
@@ -333,28 +388,3 @@ void vvl::Queue::Retire(QueueSubmission &submission) {
         submission.fence->Retire();
     }
 }
-
-void vvl::Queue::ThreadFunc() {
-    VVL_TracySetThreadName(__FUNCTION__);
-
-    QueueSubmission *submission = nullptr;
-
-    // Roll this queue forward, one submission at a time.
-    while (true) {
-        submission = NextSubmission();
-        if (submission == nullptr) {
-            break;
-        }
-        Retire(*submission);
-        // wake up anyone waiting for this submission to be retired
-        {
-            std::promise<void> completed;
-            {
-                auto guard = Lock();
-                completed = std::move(submission->completed);
-                submissions_.pop_front();
-            }
-            completed.set_value();
-        }
-    }
-}
@@ -127,15 +127,18 @@ class Queue : public StateObject, public SubStateManager<QueueSubState> {
     // called from the various PostCallRecordQueueSubmit() methods
     void PostSubmit();
 
-    // Tell the queue thread that submissions up to and including the submission with
-    // sequence number until_seq have finished. kU64Max means to finish all submissions.
+    // Tell the queue that submissions up to and including the submission with sequence number
+    // until_seq have finished. They are retired in the background by the device's thread pool.
+    // kU64Max means to finish all submissions.
     void Notify(uint64_t until_seq = kU64Max);
 
-    // Wait for the queue thread to finish processing submissions with sequence numbers
-    // up to and including until_seq. kU64Max means to finish all submissions.
+    // Wait for submissions with sequence numbers up to and including until_seq to be retired.
+    // If no other thread is retiring this queue's submissions, they are retired on the calling
+    // thread instead of waiting for the thread pool. kU64Max means to finish all submissions.
     void Wait(const Location &loc, uint64_t until_seq = kU64Max);
 
-    // Helper that combines Notify and Wait
+    // Helper that combines Notify and Wait. Never goes through the thread pool, the submissions
+    // are retired on the calling thread unless another thread is already retiring them.
     void NotifyAndWait(const Location &loc, uint64_t until_seq = kU64Max);
 
     // Find a timeline wait that does not have a resolving signal submitted yet.
@@ -175,7 +178,7 @@ class Queue : public StateObject, public SubStateManager<QueueSubState> {
     // called from the various PostCallRecordQueueSubmit() methods
     void PostSubmit(QueueSubmission &submission);
 
-    // called when the worker thread decides a submissions has finished executing
+    // called when a submission has finished executing, submissions are always retired in order
     void Retire(QueueSubmission &submission);
 
   private:
@@ -183,22 +186,36 @@ class Queue : public StateObject, public SubStateManager<QueueSubState> {
 
   private:
     using LockGuard = std::unique_lock<std::mutex>;
-    void ThreadFunc();
-    QueueSubmission *NextSubmission();
     LockGuard Lock() const { return LockGuard(lock_); }
 
+    // Thread pool task, retires everything that is ready
+    void RetireTask();
+    // Retire ready submissions up to and including until_seq, in one go. lock_ must be held and
+    // retiring_ claimed by the caller, the lock is dropped around each Retire() call.
+    void RetireSubmissions(LockGuard &guard, uint64_t until_seq);
+    bool HasReadySubmission(uint64_t until_seq) const;
+    // Returns true if the caller has to post a RetireTask, lock_ must be held
+    bool ScheduleRetire();
+
     DeviceState &dev_data_;
 
     // state related to submitting to the queue, all data members must
     // be accessed with lock_ held
-    std::unique_ptr<std::thread> thread_;
     std::deque<QueueSubmission> submissions_;
     std::atomic<uint64_t> seq_{0};
+    // Every submission up to and including retired_seq_ has been retired. Can be read without lock_,
+    // so polling a fence or semaphore that already completed doesn't have to touch the queue's lock.
+    std::atomic<uint64_t> retired_seq_{0};
     uint64_t request_seq_{0};
-    bool exit_thread_{false};
+    // Submissions are retired by at most one thread at a time, either a thread pool task or a thread
+    // helping out in Wait(). This keeps retirement in submission order without a thread per queue.
+    bool retiring_{false};
+    // A RetireTask is queued on the thread pool and has not started yet
+    bool retire_posted_{false};
+    bool exit_{false};
     mutable std::mutex lock_;
-    // condition to wake up the queue's thread
-    std::condition_variable cond_;
+    // signaled when retirement stops or a posted RetireTask starts, Destroy() waits for both to be done
+    std::condition_variable idle_cond_;
 };
 
 class QueueSubState {
@@ -33,11 +33,6 @@ static VkExternalSemaphoreHandleTypeFlags GetExportHandleTypes(const VkSemaphore
     return export_info ? export_info->handleTypes : 0;
 }
 
-void vvl::Semaphore::TimePoint::Notify() const {
-    assert(signal_submit.has_value() && signal_submit->queue);
-    signal_submit->queue->Notify(signal_submit->seq);
-}
-
 vvl::Semaphore::Semaphore(DeviceState &dev, VkSemaphore handle, const VkSemaphoreTypeCreateInfo *type_create_info,
                           const VkSemaphoreCreateInfo *pCreateInfo)
     : RefcountedStateObject(handle, kVulkanObjectTypeSemaphore),
@@ -99,15 +94,32 @@ enum vvl::Semaphore::Scope vvl::Semaphore::Scope() const {
     return scope_;
 }
 
+vvl::Semaphore::TimePoint &vvl::Semaphore::GetTimePoint(uint64_t payload) {
+    // Fast path, payloads are almost always increasing
+    if (timeline_.empty() || timeline_.back().first < payload) {
+        return timeline_.emplace_back(payload, TimePoint{}).second;
+    }
+    auto it = timeline_.begin() + (LowerBound(payload) - timeline_.cbegin());
+    if (it->first != payload) {
+        it = timeline_.emplace(it, payload, TimePoint{});
+    }
+    return it->second;
+}
+
 void vvl::Semaphore::EnqueueSignal(const SubmissionReference &signal_submit, uint64_t &payload) {
     auto guard = WriteLock();
     if (type == VK_SEMAPHORE_TYPE_BINARY) {
         payload = next_payload_++;
     }
     // Check there is no existing signal, validation should enforce this
-    assert(timeline_.find(payload) == timeline_.end() || !timeline_.find(payload)->second.signal_submit.has_value());
+    assert(!FindTimePoint(payload) || !FindTimePoint(payload)->signal_submit.has_value());
 
-    timeline_[payload].signal_submit.emplace(signal_submit);
+    GetTimePoint(payload).signal_submit.emplace(signal_submit);
+    if (signal_payloads_.empty() || signal_payloads_.back() < payload) {
+        signal_payloads_.push_back(payload);
+    } else {
+        signal_payloads_.insert(std::lower_bound(signal_payloads_.begin(), signal_payloads_.end(), payload), payload);
+    }
 }
 
 void vvl::Semaphore::EnqueueWait(const SubmissionReference &wait_submit, uint64_t &payload) {
@@ -135,54 +147,59 @@ void vvl::Semaphore::EnqueueWait(const SubmissionReference &wait_submit, uint64_
         // NOTE: wait's submission can still be pending, but timepoint lifetime logic
         // is determined by the signal. completed_ is updated when signal is retired.
         // The matching waits should be resolved against completed_ in this case.
-        assert(!vvl::Contains(timeline_, payload));
+        assert(!FindTimePoint(payload));
         completed_.op_type = kWait;
         completed_.submit = wait_submit;
         return;
     }
 
-    timeline_[payload].wait_submits.emplace_back(wait_submit);
+    GetTimePoint(payload).wait_submits.emplace_back(wait_submit);
 }
 
 void vvl::Semaphore::EnqueueAcquire(vvl::Func acquire_command) {
     assert(type == VK_SEMAPHORE_TYPE_BINARY);
     auto guard = WriteLock();
     auto payload = next_payload_++;
-    assert(timeline_.find(payload) == timeline_.end());
-    timeline_[payload].acquire_command.emplace(acquire_command);
+    assert(!FindTimePoint(payload));
+    GetTimePoint(payload).acquire_command.emplace(acquire_command);
 }
 
-std::optional<vvl::Semaphore::SemOp> vvl::Semaphore::LastOp(const std::function<bool(OpType, uint64_t, bool)> &filter) const {
+std::optional<vvl::Semaphore::SemOp> vvl::Semaphore::LastPendingSignal(uint64_t max_payload) const {
     auto guard = ReadLock();
-    std::optional<SemOp> result;
-
-    for (auto pos = timeline_.rbegin(); pos != timeline_.rend(); ++pos) {
-        uint64_t payload = pos->first;
-        auto &timepoint = pos->second;
-        for (auto &op : timepoint.wait_submits) {
-            if (!filter || filter(kWait, payload, true)) {
-                result.emplace(SemOp(kWait, op, payload));
-                break;
-            }
+    auto it = std::upper_bound(signal_payloads_.begin(), signal_payloads_.end(), max_payload);
+    while (it != signal_payloads_.begin()) {
+        --it;
+        const TimePoint *timepoint = FindTimePoint(*it);
+        assert(timepoint && timepoint->signal_submit.has_value());
+        // vkSemaphoreSignal can't be a pending operation, it signals immediately
+        if (timepoint->signal_submit->queue != nullptr) {
+            return SemOp(kSignal, *timepoint->signal_submit, *it);
         }
-        if (!result && timepoint.signal_submit) {
-            // vkSemaphoreSignal can't be a pending operation, it signals immediately
-            const bool pending = timepoint.signal_submit->queue != nullptr;
+    }
+    return {};
+}
 
-            if (!filter || filter(kSignal, payload, pending)) {
-                result.emplace(SemOp(kSignal, *timepoint.signal_submit, payload));
-                break;
-            }
+std::optional<vvl::Semaphore::SemOp> vvl::Semaphore::LastOpOutsideRange(uint64_t min_payload, uint64_t max_payload) const {
+    auto guard = ReadLock();
+    auto any_op = [](OpType, uint64_t, bool) { return true; };
+    // Above the range
+    for (auto pos = timeline_.rbegin(); pos != timeline_.rend() && pos->first > max_payload; ++pos) {
+        if (auto result = FindOp(pos->first, pos->second, any_op)) {
+            return result;
         }
-        if (!result && timepoint.acquire_command && (!filter || filter(kBinaryAcquire, payload, true))) {
-            result.emplace(SemOp(*timepoint.acquire_command, payload));
-            break;
+    }
+    // Below the range
+    const auto range_begin = LowerBound(min_payload);
+    for (auto pos = timeline_.begin() + (range_begin - timeline_.cbegin()); pos != timeline_.begin();) {
+        --pos;
+        if (auto result = FindOp(pos->first, pos->second, any_op)) {
+            return result;
         }
     }
-    if (!result && (!filter || filter(completed_.op_type, completed_.payload, false))) {
-        result.emplace(completed_);
+    if (completed_.payload < min_payload || completed_.payload > max_payload) {
+        return completed_;
     }
-    return result;
+    return {};
 }
 
 std::optional<vvl::SubmissionReference> vvl::Semaphore::GetPendingBinaryWaitSubmission() const {
@@ -292,19 +309,11 @@ bool vvl::Semaphore::HasResolvingTimelineSignal(uint64_t wait_payload) const {
         return true;
     }
 
-    auto it = timeline_.find(wait_payload);
-    assert(it != timeline_.end());  // for each registered wait there is a timepoint
-    while (it != timeline_.end()) {
-        if (it->second.signal_submit.has_value()) {
-            assert(it->first >= wait_payload);  // timepoints are ordered in increasing order
-            return true;
-        }
-        ++it;
-    }
-    return false;
+    assert(FindTimePoint(wait_payload));  // for each registered wait there is a timepoint
+    return std::lower_bound(signal_payloads_.begin(), signal_payloads_.end(), wait_payload) != signal_payloads_.end();
 }
 
-bool vvl::Semaphore::CanRetireBinaryWait(TimePoint &timepoint) const {
+bool vvl::Semaphore::CanRetireBinaryWait(TimePoint &timepoint, SubmissionReference &resolving_signal) const {
     assert(type == VK_SEMAPHORE_TYPE_BINARY);
     // The only allowed configuration when binary semaphore wait does not have a signal
     // is external semaphore. Just retire the wait because there is no guarantee we can
@@ -316,52 +325,62 @@ bool vvl::Semaphore::CanRetireBinaryWait(TimePoint &timepoint) const {
 
     // The resolving signal can only be on another queue (the earlier signals on the
     // current queue are already processed and corresponding timepoints are retired).
-    // Initiate forward progress on signaling queue and ask the caller to wait.
-    timepoint.Notify();
+    // The caller has to make progress on the signaling queue and wait.
+    assert(timepoint.signal_submit->queue);
+    resolving_signal = *timepoint.signal_submit;
     return false;
 }
 
-bool vvl::Semaphore::CanRetireTimelineWait(const vvl::Queue *current_queue, uint64_t payload) const {
+bool vvl::Semaphore::CanRetireTimelineWait(const vvl::Queue *current_queue, uint64_t payload,
+                                           SubmissionReference &resolving_signal) const {
     assert(type == VK_SEMAPHORE_TYPE_TIMELINE);
 
     // In the correct program the resolving signal is the next signal on the timeline,
     // otherwise this violates the rule of strictly increasing signal values.
-    auto it = timeline_.find(payload);
-    assert(it != timeline_.end());
-    for (; it != timeline_.end(); ++it) {
-        const TimePoint &t = it->second;
-        if (!t.signal_submit.has_value()) {
-            continue;
-        }
+    assert(FindTimePoint(payload));
+    const TimePoint *resolving_timepoint = nullptr;
+    for (auto it = std::lower_bound(signal_payloads_.begin(), signal_payloads_.end(), payload); it != signal_payloads_.end();
+         ++it) {
+        const TimePoint *timepoint = FindTimePoint(*it);
+        assert(timepoint && timepoint->signal_submit.has_value());
         // If the next signal is on the waiting (current) queue, it can't be a resolving signal (blocked by wait).
         // QueueSubmissionValidator will also report an error about non-increasing signal values
-        if (t.signal_submit->queue != nullptr && t.signal_submit->queue == current_queue) {
+        if (timepoint->signal_submit->queue != nullptr && timepoint->signal_submit->queue == current_queue) {
             continue;
         }
         // Found the resolving signal
+        resolving_timepoint = timepoint;
         break;
     }
 
     // There is always a resolving signal when we reach a retirement phase (CPU successfully finished waiting on GPU).
     // For external semaphore we might not have visibility of this signal. Just retire the wait.
-    if (it == timeline_.end()) {
+    if (!resolving_timepoint) {
         assert(scope_ != kInternal);
         return true;
     }
 
     // Found host signal that finishes this wait
-    const TimePoint &t = it->second;
+    const TimePoint &t = *resolving_timepoint;
     if (t.signal_submit->queue == nullptr) {
         return true;
     }
 
-    // Notify signaling queue and wait for its queue thread
-    t.Notify();
+    // The caller has to make progress on the signaling queue and wait for it to retire the signal
+    resolving_signal = *t.signal_submit;
     return false;
 }
 
 void vvl::Semaphore::RetireWait(vvl::Queue *current_queue, uint64_t payload, const Location &loc, bool queue_thread) {
+    {
+        // Polling a payload that was already reached is the common case, don't serialize it with the write lock
+        auto guard = ReadLock();
+        if (payload <= completed_.payload) {
+            return;
+        }
+    }
     std::shared_future<void> waiter;
+    SubmissionReference resolving_signal;
     bool retire_external_payload = false;
     uint64_t external_payload = 0;
     {
@@ -370,23 +389,25 @@ void vvl::Semaphore::RetireWait(vvl::Queue *current_queue, uint64_t payload, con
             return;
         }
         if (scope_ != kInternal) {
-            if (!vvl::Find(timeline_, payload)) {
+            if (!FindTimePoint(payload)) {
                 // GetSemaphoreCounterValue for external semaphore might not have a registered timepoint.
                 // Add timepoint so we can retire timeline up to that point.
                 assert(type == VK_SEMAPHORE_TYPE_TIMELINE);
-                auto payload_it = timeline_.insert({payload, TimePoint{}}).first;
+                GetTimePoint(payload);
 
                 // Search existing signal. If found, notify corresponding submission.
                 // (external payload, which is already reached by the gpu, is larger then found signal,
                 // this means that earlier signals were also processed, so we can retire them)
-                for (auto it = std::make_reverse_iterator(payload_it); it != timeline_.rend(); ++it) {
-                    const TimePoint &t = it->second;
-                    if (t.signal_submit.has_value() && t.signal_submit->queue) {
+                auto it = std::lower_bound(signal_payloads_.begin(), signal_payloads_.end(), payload);
+                while (it != signal_payloads_.begin()) {
+                    --it;
+                    const TimePoint *t = FindTimePoint(*it);
+                    if (t->signal_submit->queue) {
                         retire_external_payload = true;
                         external_payload = payload;
                         // Update payload value to retire existing signal.
                         // External payload will be retired after that to update current payload value.
-                        payload = it->first;
+                        payload = *it;
                         break;
                     }
                 }
@@ -396,15 +417,15 @@ void vvl::Semaphore::RetireWait(vvl::Queue *current_queue, uint64_t payload, con
                 imported_handle_type_.reset();
             }
         }
-        TimePoint &timepoint = vvl::FindExisting(timeline_, payload);
+        TimePoint &timepoint = *FindTimePoint(payload);
 
         bool retire = false;
         if (timepoint.acquire_command) {
             retire = true;  // There is resolving acquire signal, timepoint can be retired
         } else if (type == VK_SEMAPHORE_TYPE_BINARY) {
-            retire = CanRetireBinaryWait(timepoint);
+            retire = CanRetireBinaryWait(timepoint, resolving_signal);
         } else {
-            retire = CanRetireTimelineWait(current_queue, payload);
+            retire = CanRetireTimelineWait(current_queue, payload, resolving_signal);
         }
         if (retire) {
             // SemOp::submit is used only by the binary semaphores.
@@ -421,6 +442,12 @@ void vvl::Semaphore::RetireWait(vvl::Queue *current_queue, uint64_t payload, con
         waiter = timepoint.waiter;
     }
 
+    // Queues are retired by a shared thread pool, so help the signaling queue along instead of only blocking on it.
+    // Otherwise every pool thread could end up here, waiting on a queue that never gets a thread to retire it.
+    // This is done without the semaphore lock, retiring the signal needs it.
+    if (resolving_signal.queue) {
+        resolving_signal.queue->NotifyAndWait(loc, resolving_signal.seq);
+    }
     WaitTimePoint(std::move(waiter), payload, !queue_thread, loc);
 
     if (retire_external_payload) {
@@ -434,7 +461,7 @@ void vvl::Semaphore::RetireSignal(uint64_t payload) {
     if (payload <= completed_.payload) {
         return;
     }
-    TimePoint &timepoint = vvl::FindExisting(timeline_, payload);
+    TimePoint &timepoint = *FindTimePoint(payload);
     assert(timepoint.signal_submit.has_value());
 
     OpType completed_op = kSignal;
@@ -461,6 +488,9 @@ void vvl::Semaphore::RetireTimePoint(uint64_t payload, OpType completed_op, Subm
         ++it;
     }
     timeline_.erase(timeline_.begin(), it);
+    while (!signal_payloads_.empty() && signal_payloads_.front() <= payload) {
+        signal_payloads_.pop_front();
+    }
     completed_ = SemOp(completed_op, completed_submit, payload);
 }
 
@@ -19,10 +19,13 @@
 #pragma once
 #include "state_tracker/state_object.h"
 #include "state_tracker/submission_reference.h"
+#include <algorithm>
+#include <deque>
 #include <future>
 #include <optional>
 #include <map>
 #include <shared_mutex>
+#include <utility>
 #include "error_message/error_location.h"
 
 namespace vvl {
@@ -81,7 +84,6 @@ class Semaphore : public RefcountedStateObject {
         TimePoint() : completed(), waiter(completed.get_future()) {}
         bool HasSignaler() const { return signal_submit.has_value() || acquire_command.has_value(); }
         bool HasWaiters() const { return !wait_submits.empty(); }
-        void Notify() const;
     };
 
     Semaphore(DeviceState &dev, VkSemaphore handle, const VkSemaphoreCreateInfo *pCreateInfo)
@@ -111,8 +113,16 @@ class Semaphore : public RefcountedStateObject {
     // Process signal by retiring timeline timepoints up to the specified payload
     void RetireSignal(uint64_t payload);
 
-    // Look for most recent / highest payload operation that matches
-    std::optional<SemOp> LastOp(const std::function<bool(OpType op_type, uint64_t payload, bool is_pending)> &filter) const;
+    // Look for most recent / highest payload operation that matches filter(OpType op_type, uint64_t payload, bool is_pending).
+    // Only timepoints with payload >= min_payload are visited, the completed operation is always checked last.
+    template <typename Filter>
+    std::optional<SemOp> LastOp(Filter &&filter, uint64_t min_payload = 0) const;
+
+    // Highest payload pending signal with payload <= max_payload
+    std::optional<SemOp> LastPendingSignal(uint64_t max_payload) const;
+
+    // Highest payload operation (including the completed one) with payload outside of [min_payload, max_payload]
+    std::optional<SemOp> LastOpOutsideRange(uint64_t min_payload, uint64_t max_payload) const;
 
     // Returns pending queue submission that waits on this binary semaphore.
     std::optional<SubmissionReference> GetPendingBinaryWaitSubmission() const;
@@ -160,12 +170,29 @@ class Semaphore : public RefcountedStateObject {
 
     // Return true if timepoint has no dependencies and can be retired.
     // If there is unresolved wait then notify signaling queue (if there is registered signal) and return false
-    bool CanRetireBinaryWait(TimePoint &timepoint) const;
-    bool CanRetireTimelineWait(const vvl::Queue *current_queue, uint64_t payload) const;
+    // When the wait can't be retired yet, resolving_signal is set to the submission that has to be retired first
+    bool CanRetireBinaryWait(TimePoint &timepoint, SubmissionReference &resolving_signal) const;
+    bool CanRetireTimelineWait(const vvl::Queue *current_queue, uint64_t payload, SubmissionReference &resolving_signal) const;
 
     // Mark timepoints up to and including payload as completed (notify waiters) and remove them from timeline
     void RetireTimePoint(uint64_t payload, OpType completed_op, SubmissionReference completed_submit);
 
+    using Timeline = std::deque<std::pair<uint64_t, TimePoint>>;
+    Timeline::const_iterator LowerBound(uint64_t payload) const {
+        return std::lower_bound(timeline_.begin(), timeline_.end(), payload,
+                                [](const Timeline::value_type &entry, uint64_t value) { return entry.first < value; });
+    }
+    const TimePoint *FindTimePoint(uint64_t payload) const {
+        auto it = LowerBound(payload);
+        return (it != timeline_.end() && it->first == payload) ? &it->second : nullptr;
+    }
+    TimePoint *FindTimePoint(uint64_t payload) { return const_cast<TimePoint *>(std::as_const(*this).FindTimePoint(payload)); }
+    // Returns the timepoint for payload, adding it if it doesn't exist yet
+    TimePoint &GetTimePoint(uint64_t payload);
+    // Operations of a timepoint in the order LastOp() visits them
+    template <typename Filter>
+    std::optional<SemOp> FindOp(uint64_t payload, const TimePoint &timepoint, Filter &&filter) const;
+
     // Waits for the waiter. Unblock parameter must be true if the caller is a validation object and false otherwise.
     // (validation object has to use {Begin/End}BlockingOperation() when waiting for the timepoint)
     void WaitTimePoint(std::shared_future<void> &&waiter, uint64_t payload, bool unblock_validation_object, const Location &loc);
@@ -182,8 +209,13 @@ class Semaphore : public RefcountedStateObject {
 
     // Set of pending operations ordered by payload.
     // Timeline operations can be added in any order and multiple wait operations
-    // can use the same payload value.
-    std::map<uint64_t, TimePoint> timeline_;
+    // can use the same payload value. In practice payloads almost always increase,
+    // so this is a sorted deque: adding at the back and retiring from the front are
+    // cheap, and lookups are a binary search.
+    Timeline timeline_;
+    // Payloads of the timepoints with a signal_submit, sorted. Answers "next signal >= payload"
+    // without walking the waits in between.
+    std::deque<uint64_t> signal_payloads_;
     mutable std::shared_mutex lock_;
     DeviceState &dev_data_;
 
@@ -192,4 +224,40 @@ class Semaphore : public RefcountedStateObject {
     std::optional<SwapchainWaitInfo> swapchain_wait_info_;
 };
 
+template <typename Filter>
+std::optional<Semaphore::SemOp> Semaphore::FindOp(uint64_t payload, const TimePoint &timepoint, Filter &&filter) const {
+    for (auto &op : timepoint.wait_submits) {
+        if (filter(kWait, payload, true)) {
+            return SemOp(kWait, op, payload);
+        }
+    }
+    if (timepoint.signal_submit) {
+        // vkSemaphoreSignal can't be a pending operation, it signals immediately
+        const bool pending = timepoint.signal_submit->queue != nullptr;
+        if (filter(kSignal, payload, pending)) {
+            return SemOp(kSignal, *timepoint.signal_submit, payload);
+        }
+    }
+    if (timepoint.acquire_command && filter(kBinaryAcquire, payload, true)) {
+        return SemOp(*timepoint.acquire_command, payload);
+    }
+    return {};
+}
+
+template <typename Filter>
+std::optional<Semaphore::SemOp> Semaphore::LastOp(Filter &&filter, uint64_t min_payload) const {
+    auto guard = ReadLock();
+    const auto first = LowerBound(min_payload);
+    for (auto pos = timeline_.end(); pos != first;) {
+        --pos;
+        if (auto result = FindOp(pos->first, pos->second, filter)) {
+            return result;
+        }
+    }
+    if (filter(completed_.op_type, completed_.payload, false)) {
+        return completed_;
+    }
+    return {};
+}
+
 }  // namespace vvl
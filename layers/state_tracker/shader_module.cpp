@@ -18,6 +18,7 @@
 #include <sstream>
 #include <string>
 #include <queue>
+#include <mutex>
 
 #include "utils/hash_util.h"
 #include "generated/spirv_grammar_helper.h"
@@ -878,7 +879,109 @@ std::optional<VkPrimitiveTopology> Module::GetTopology(const EntryPoint& entrypo
     return result;
 }
 
-Module::StaticData::StaticData(const Module& module_state, StatelessData* stateless_data) {
+// StatelessData holds pointers into the instructions of the StaticData it was created with, so they are cached together
+struct Module::CachedStaticData {
+    StatelessData stateless_data;
+    StaticData static_data;
+};
+
+// Content addressed cache of parsed SPIR-V, shared by every VkShaderModule, VkShaderEXT and inline VkShaderModuleCreateInfo.
+// Entries are weak so the parsed data is released together with the last Module using it.
+class Module::StaticDataCache {
+  public:
+    std::shared_ptr<const CachedStaticData> Find(const hash_util::Hash128Value& key) {
+        std::lock_guard<std::mutex> guard(lock_);
+        auto it = entries_.find(key);
+        return (it != entries_.end()) ? it->second.lock() : nullptr;
+    }
+
+    // Does nothing if another thread parsed the same words first, its entry stays in the cache
+    void Insert(const hash_util::Hash128Value& key, const std::shared_ptr<const CachedStaticData>& entry) {
+        std::lock_guard<std::mutex> guard(lock_);
+        auto& cached = entries_[key];
+        if (!cached.expired()) {
+            return;
+        }
+        cached = entry;
+
+        // Drop the expired entries once in a while, amortized over the inserts
+        if (entries_.size() >= sweep_threshold_) {
+            for (auto it = entries_.begin(); it != entries_.end();) {
+                if (it->second.expired()) {
+                    it = entries_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            sweep_threshold_ = std::max(kMinSweepThreshold, entries_.size() * 2);
+        }
+    }
+
+  private:
+    static constexpr size_t kMinSweepThreshold = 64;
+
+    std::mutex lock_;
+    vvl::unordered_map<hash_util::Hash128Value, std::weak_ptr<const CachedStaticData>, hash_util::Hash128ValueHash> entries_;
+    size_t sweep_threshold_ = kMinSweepThreshold;
+};
+
+Module::StaticDataCache Module::static_data_cache_;
+
+Module::StaticDataLookUp Module::LookUpStaticData(bool is_valid_spirv, const std::vector<uint32_t>& words) {
+    StaticDataLookUp look_up;
+    if (is_valid_spirv) {
+        look_up.key = hash_util::Hash128(words.data(), words.size() * sizeof(uint32_t));
+        look_up.cached = static_data_cache_.Find(look_up.key);
+    }
+    if (!look_up.cached) {
+        look_up.unparsed = std::make_shared<CachedStaticData>();
+    }
+    return look_up;
+}
+
+std::shared_ptr<const Module::StaticData> Module::GetStaticData(const StaticDataLookUp& look_up) {
+    // Aliasing constructor, keeps the whole entry alive
+    if (look_up.cached) {
+        return std::shared_ptr<const StaticData>(look_up.cached, &look_up.cached->static_data);
+    }
+    return std::shared_ptr<const StaticData>(look_up.unparsed, &look_up.unparsed->static_data);
+}
+
+Module::Module(bool is_valid_spirv, std::vector<uint32_t>&& words, StatelessData* stateless_data, StaticDataLookUp&& look_up)
+    : valid_spirv(is_valid_spirv),
+      words_(std::move(words)),
+      static_data_owner_(GetStaticData(look_up)),
+      static_data_(*static_data_owner_) {
+    std::shared_ptr<const CachedStaticData> entry = std::move(look_up.cached);
+    if (auto& unparsed = look_up.unparsed) {
+        // static_data_ refers to the StaticData being parsed, which is only visible to this Module until it is cached
+        unparsed->static_data.Parse(*this, &unparsed->stateless_data);
+        if (unparsed->stateless_data.has_group_decoration) {
+            // Parsing stopped early as this needs to be flattened by spirv-opt first, so it is not worth caching
+            if (stateless_data) {
+                stateless_data->has_group_decoration = true;
+            } else {
+                unparsed->static_data = StaticData();
+                unparsed->static_data.Parse(*this, nullptr);
+            }
+            return;
+        }
+        if (!valid_spirv) {
+            return;
+        }
+        entry = std::move(unparsed);
+        static_data_cache_.Insert(look_up.key, entry);
+    }
+
+    if (stateless_data) {
+        // The pNext module is set by the caller, not found while parsing
+        auto pipeline_pnext_module = std::move(stateless_data->pipeline_pnext_module);
+        *stateless_data = entry->stateless_data;
+        stateless_data->pipeline_pnext_module = std::move(pipeline_pnext_module);
+    }
+}
+
+void Module::StaticData::Parse(const Module& module_state, StatelessData* stateless_data) {
     if (!module_state.valid_spirv) return;
 
     // Parse the words first so we have instruction class objects to use
@@ -31,6 +31,7 @@
 #include "state_tracker/sampler_state.h"
 #include <spirv/unified1/spirv.hpp>
 #include "containers/limits.h"
+#include "utils/hash_util.h"
 
 namespace vvl {
 class Pipeline;
@@ -599,7 +600,8 @@ struct Module {
     // The goal of this struct is to move everything that is ready only into here
     struct StaticData {
         StaticData() = default;
-        StaticData(const Module &module_state, StatelessData *stateless_data = nullptr);
+        // The parsing code looks definitions up through |module_state|, so its static_data_ must already refer to this object
+        void Parse(const Module &module_state, StatelessData *stateless_data);
         StaticData &operator=(StaticData &&) = default;
         StaticData(StaticData &&) = default;
 
@@ -672,20 +674,22 @@ struct Module {
     // This is the SPIR-V module data content
     const std::vector<uint32_t> words_;
 
-    const StaticData static_data_;
+    // Parsing is content addressed: every Module created from the same SPIR-V words shares one immutable StaticData,
+    // so reflection only runs once per unique blob (see LookUpStaticData)
+    const std::shared_ptr<const StaticData> static_data_owner_;
+    const StaticData &static_data_;
 
     // Hold a handle so error message can know where the SPIR-V was from (VkShaderModule or VkShaderEXT)
     VulkanTypedHandle handle_;                            // Will be updated once its known its valid SPIR-V
     VulkanTypedHandle handle() const { return handle_; }  // matches normal convention to get handle
 
     // Used for when modifying the SPIR-V (spirv-opt, GPU-AV instrumentation, etc) and need reparse it for VVL validation
-    Module(vvl::span<const uint32_t> code) : valid_spirv(true), words_(code.begin(), code.end()), static_data_(*this) {}
+    Module(vvl::span<const uint32_t> code) : Module(true, std::vector<uint32_t>(code.begin(), code.end()), nullptr) {}
 
     // StatelessData is a pointer as we have cases were we don't need it and simpler to just null check the few cases that use it
     Module(size_t codeSize, const uint32_t *pCode, StatelessData *stateless_data = nullptr)
-        : valid_spirv(pCode && pCode[0] == spv::MagicNumber && ((codeSize % 4) == 0)),
-          words_(pCode, pCode + codeSize / sizeof(uint32_t)),
-          static_data_(*this, stateless_data) {}
+        : Module(pCode && pCode[0] == spv::MagicNumber && ((codeSize % 4) == 0),
+                 std::vector<uint32_t>(pCode, pCode + codeSize / sizeof(uint32_t)), stateless_data) {}
 
     const Instruction *FindDef(uint32_t id) const {
         auto it = static_data_.definitions.find(id);
@@ -751,6 +755,28 @@ struct Module {
         return std::any_of(static_data_.capability_list.begin(), static_data_.capability_list.end(),
                            [find_capability](const spv::Capability &capability) { return capability == find_capability; });
     }
+
+  private:
+    struct CachedStaticData;
+    class StaticDataCache;
+    static StaticDataCache static_data_cache_;
+
+    struct StaticDataLookUp {
+        hash_util::Hash128Value key;
+        // Set on a hit
+        std::shared_ptr<const CachedStaticData> cached;
+        // Set on a miss, parsed by the Module constructor once static_data_ refers to it
+        std::shared_ptr<CachedStaticData> unparsed;
+    };
+
+    // The words are only moved into words_ by the target constructor, after LookUpStaticData hashed them
+    Module(bool is_valid_spirv, std::vector<uint32_t> &&words, StatelessData *stateless_data)
+        : Module(is_valid_spirv, std::move(words), stateless_data, LookUpStaticData(is_valid_spirv, words)) {}
+    Module(bool is_valid_spirv, std::vector<uint32_t> &&words, StatelessData *stateless_data, StaticDataLookUp &&look_up);
+
+    // Looks up the StaticData of identical SPIR-V words (keyed by a 128-bit XXH3 hash)
+    static StaticDataLookUp LookUpStaticData(bool is_valid_spirv, const std::vector<uint32_t> &words);
+    static std::shared_ptr<const StaticData> GetStaticData(const StaticDataLookUp &look_up);
 };
 
 }  // namespace spirv
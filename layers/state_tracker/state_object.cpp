@@ -1,7 +1,7 @@
-/* Copyright (c) 2015-2024 The Khronos Group Inc.
- * Copyright (c) 2015-2024 Valve Corporation
- * Copyright (c) 2015-2024 LunarG, Inc.
- * Copyright (C) 2015-2024 Google Inc.
+/* Copyright (c) 2015-2025 The Khronos Group Inc.
+ * Copyright (c) 2015-2025 Valve Corporation
+ * Copyright (c) 2015-2025 LunarG, Inc.
+ * Copyright (C) 2015-2025 Google Inc.
  * Modifications Copyright (C) 2020 Advanced Micro Devices, Inc. All rights reserved.
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
@@ -18,6 +18,86 @@
  */
 #include "state_tracker/state_object.h"
 
+bool vvl::ParentNodes::Insert(const VulkanTypedHandle& handle, std::weak_ptr<StateObject>&& node) {
+    if (overflow_) {
+        return overflow_->emplace(handle, std::move(node)).second;
+    }
+    for (const auto& entry : inline_) {
+        if (entry.handle == handle) {
+            return false;
+        }
+    }
+    if (inline_.size() < kMaxInlineParents) {
+        // small_vector::reserve grows to exactly the requested size, so grow geometrically here
+        if (inline_.size() == inline_.capacity()) {
+            inline_.reserve(inline_.capacity() * 2);
+        }
+        inline_.emplace_back(ParentNode{handle, std::move(node)});
+        return true;
+    }
+
+    overflow_ = std::make_unique<OverflowMap>();
+    overflow_->reserve(kMaxInlineParents * 2);
+    for (auto& entry : inline_) {
+        overflow_->emplace(entry.handle, std::move(entry.node));
+    }
+    inline_.clear();
+    inline_.shrink_to_fit();
+    overflow_->emplace(handle, std::move(node));
+    return true;
+}
+
+void vvl::ParentNodes::Erase(const VulkanTypedHandle& handle) {
+    if (overflow_) {
+        overflow_->erase(handle);
+        return;
+    }
+    const uint32_t count = inline_.size();
+    for (uint32_t i = 0; i < count; ++i) {
+        if (inline_[i].handle == handle) {
+            // Order of parents is not meaningful, swap with the last one to avoid shifting
+            if (i != count - 1) {
+                inline_[i] = std::move(inline_[count - 1]);
+            }
+            inline_.resize(count - 1);
+            return;
+        }
+    }
+}
+
+void vvl::ParentNodes::Clear() {
+    inline_.clear();
+    inline_.shrink_to_fit();
+    overflow_.reset();
+}
+
+vvl::ParentNodes::List vvl::ParentNodes::Get() const {
+    List result;
+    if (overflow_) {
+        result.reserve(static_cast<uint32_t>(overflow_->size()));
+        for (const auto& entry : *overflow_) {
+            result.emplace_back(ParentNode{entry.first, entry.second});
+        }
+    } else {
+        result.PushBackFrom(inline_);
+    }
+    return result;
+}
+
+vvl::ParentNodes::List vvl::ParentNodes::Take() {
+    List result;
+    if (overflow_) {
+        result.reserve(static_cast<uint32_t>(overflow_->size()));
+        for (auto& entry : *overflow_) {
+            result.emplace_back(ParentNode{entry.first, std::move(entry.second)});
+        }
+    } else {
+        result.PushBackFrom(std::move(inline_));
+    }
+    Clear();
+    return result;
+}
+
 vvl::StateObject::~StateObject() { Destroy(); }
 
 void vvl::StateObject::Destroy() {
@@ -29,48 +109,47 @@ const VulkanTypedHandle* vvl::StateObject::InUse() const {
     // NOTE: for performance reasons, this method calls up the tree
     // with the read lock held.
     auto guard = ReadLockTree();
-    for (auto& item : parent_nodes_) {
-        auto node = item.second.lock();
-        if (!node) {
-            continue;
-        }
-        if (node->InUse()) {
-            return &node->Handle();
+    const VulkanTypedHandle* in_use = nullptr;
+    parent_nodes_.AnyOf([&in_use](const VulkanTypedHandle&, const std::weak_ptr<StateObject>& weak_node) {
+        auto node = weak_node.lock();
+        if (node && node->InUse()) {
+            in_use = &node->Handle();
+            return true;
         }
-    }
-    return nullptr;
+        return false;
+    });
+    return in_use;
 }
 
 bool vvl::StateObject::AddParent(StateObject* parent_node) {
+    // weak_from_this() only touches the weak count, where shared_from_this() would also bump
+    // (and then drop) the strong count of the parent on every bind
+    auto weak_parent = parent_node->weak_from_this();
     auto guard = WriteLockTree();
-    auto result = parent_nodes_.emplace(parent_node->Handle(), std::weak_ptr<StateObject>(parent_node->shared_from_this()));
-    return result.second;
+    return parent_nodes_.Insert(parent_node->Handle(), std::move(weak_parent));
 }
 
 void vvl::StateObject::RemoveParent(StateObject* parent_node) {
     assert(parent_node);
     auto guard = WriteLockTree();
-    parent_nodes_.erase(parent_node->Handle());
+    parent_nodes_.Erase(parent_node->Handle());
 }
 
 // copy the current set of parents so that we don't need to hold the lock
 // while calling NotifyInvalidate on them, as that would lead to recursive locking.
 vvl::StateObject::NodeMap vvl::StateObject::GetParentsForInvalidate(bool unlink) {
-    NodeMap result;
     if (unlink) {
         auto guard = WriteLockTree();
-        result = std::move(parent_nodes_);
-        parent_nodes_.clear();
+        return parent_nodes_.Take();
     } else {
         auto guard = ReadLockTree();
-        result = parent_nodes_;
+        return parent_nodes_.Get();
     }
-    return result;
 }
 
 vvl::StateObject::NodeMap vvl::StateObject::ObjectBindings() const {
     auto guard = ReadLockTree();
-    return parent_nodes_;
+    return parent_nodes_.Get();
 }
 
 void vvl::StateObject::Invalidate(bool unlink) {
@@ -91,7 +170,7 @@ void vvl::StateObject::NotifyInvalidate(const NodeList& invalid_nodes, bool unli
     NodeList up_nodes = invalid_nodes;
     up_nodes.emplace_back(shared_from_this());
     for (auto& item : current_parents) {
-        auto node = item.second.lock();
+        auto node = item.node.lock();
         if (node && !node->Destroyed()) {
             node->NotifyInvalidate(up_nodes, unlink);
         }
@@ -27,6 +27,7 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
 
 // Intentionally ignore VulkanTypedHandle::node, it is optional
 inline bool operator==(const VulkanTypedHandle &a, const VulkanTypedHandle &b) noexcept {
@@ -40,16 +41,71 @@ struct hash<VulkanTypedHandle> {
 }  // namespace std
 
 namespace vvl {
+class StateObject;
+
+// Back reference from a child state object to one of its parents.
+// Parent nodes are stored as weak_ptrs to avoid cyclic memory dependencies. The handle is kept
+// alongside so that specific parent types can be looked for without locking every weak_ptr.
+struct ParentNode {
+    VulkanTypedHandle handle;
+    std::weak_ptr<StateObject> node;
+};
+
+// Set of parent back references of a StateObject.
+//
+// Almost every object (images, buffers, views, samplers, ...) only has a handful of parents, so these are kept
+// in a small inline array that is searched linearly, which avoids hashing and any heap allocation on the
+// AddParent/RemoveParent paths taken by every descriptor update and command buffer bind.
+// Objects that become heavily shared (ex. an immutable sampler referenced by every descriptor set) overflow
+// into a hash map once they have more than kMaxInlineParents parents, keeping insert/erase O(1).
+//
+// Not thread safe, StateObject guards it with its tree lock.
+class ParentNodes {
+  public:
+    using List = small_vector<ParentNode, 4, uint32_t>;
+    static constexpr uint32_t kMaxInlineParents = 8;
+
+    bool empty() const { return overflow_ ? overflow_->empty() : inline_.empty(); }
+    size_t size() const { return overflow_ ? overflow_->size() : inline_.size(); }
+
+    // Returns false if the handle was already present
+    bool Insert(const VulkanTypedHandle &handle, std::weak_ptr<StateObject> &&node);
+    void Erase(const VulkanTypedHandle &handle);
+    void Clear();
+
+    // Copy (or move out with Take) the current parents so they can be walked without the tree lock held
+    List Get() const;
+    List Take();
+
+    // Visit each parent, stopping if the function returns true
+    template <typename Fn>
+    bool AnyOf(Fn &&fn) const {
+        if (overflow_) {
+            for (const auto &entry : *overflow_) {
+                if (fn(entry.first, entry.second)) return true;
+            }
+        } else {
+            for (const auto &entry : inline_) {
+                if (fn(entry.handle, entry.node)) return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    using OverflowMap = unordered_map<VulkanTypedHandle, std::weak_ptr<StateObject>>;
+
+    small_vector<ParentNode, 1, uint32_t> inline_;
+    // Only allocated once inline_ would grow past kMaxInlineParents
+    std::unique_ptr<OverflowMap> overflow_;
+};
+
 // inheriting from enable_shared_from_this<> adds a method, shared_from_this(), which
 // returns a shared_ptr version of the current object. It requires the object to
 // be created with std::make_shared<> and it MUST NOT be used from the constructor
 class StateObject: public std::enable_shared_from_this<StateObject>, public TypedHandleWrapper {
   public:
-    // Parent nodes are stored as weak_ptrs to avoid cyclic memory dependencies.
-    // Because weak_ptrs cannot safely be used as hash keys, the parents are stored
-    // in a map keyed by VulkanTypedHandle. This also allows looking for specific
-    // parent types without locking every weak_ptr.
-    using NodeMap = unordered_map<VulkanTypedHandle, std::weak_ptr<StateObject>>;
+    using NodeMap = ParentNodes::List;
     using NodeList = small_vector<std::shared_ptr<StateObject>, 4, uint32_t>;
 
     template <typename Handle>
@@ -125,7 +181,7 @@ class StateObject: public std::enable_shared_from_this<StateObject>, public Type
 
     // Set of immediate parent nodes for this object. For an in-use object, the
     // parent nodes should form a tree with the root being a command buffer.
-    NodeMap parent_nodes_;
+    ParentNodes parent_nodes_;
     // Lock guarding parent_nodes_, this lock MUST NOT be used for other purposes.
     mutable std::shared_mutex tree_lock_;
 };
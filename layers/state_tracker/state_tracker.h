@@ -30,6 +30,7 @@
 #include "containers/custom_containers.h"
 #include "utils/android_ndk_types.h"
 #include "containers/range_map.h"
+#include "utils/thread_pool.h"
 #include <vulkan/utility/vk_struct_helper.hpp>
 #include <atomic>
 #include <functional>
@@ -1928,6 +1929,9 @@ class DeviceState : public vvl::base::Device {
 
     mutable vvl::VideoProfileDesc::Cache video_profile_cache_;
 
+    // Worker threads shared by all validation objects of this device
+    vvl::ThreadPool thread_pool;
+
     using BufferAddressMapStore = small_vector<vvl::Buffer*, 1, size_t>;
     using BufferAddressRangeMap = sparse_container::range_map<VkDeviceAddress, BufferAddressMapStore>;
 
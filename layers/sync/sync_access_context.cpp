@@ -15,11 +15,15 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <atomic>
+
 #include "state_tracker/buffer_state.h"
 #include "state_tracker/video_session_state.h"
 #include "state_tracker/render_pass_state.h"
 #include "sync/sync_access_context.h"
 #include "sync/sync_image.h"
+#include "utils/thread_pool.h"
 
 bool SimpleBinding(const vvl::Bindable &bindable) { return !bindable.sparse && bindable.Binding(); }
 VkDeviceSize ResourceBaseAddress(const vvl::Buffer &buffer) { return buffer.GetFakeBaseAddress(); }
@@ -33,6 +37,7 @@ class HazardDetector {
                              QueueId queue_id) const {
         return pos->second.DetectAsyncHazard(access_info_, start_tag, queue_id);
     }
+    SyncAccessIndex GetAccessIndex() const { return access_info_.access_index; }
     explicit HazardDetector(SyncAccessIndex access_index) : access_info_(SyncStageAccess::AccessInfo(access_index)) {}
 };
 
@@ -48,6 +53,7 @@ class HazardDetectorWithOrdering {
                              QueueId queue_id) const {
         return pos->second.DetectAsyncHazard(access_info_, start_tag, queue_id);
     }
+    SyncAccessIndex GetAccessIndex() const { return access_info_.access_index; }
     HazardDetectorWithOrdering(SyncAccessIndex access_index, SyncOrdering ordering)
         : access_info_(SyncStageAccess::AccessInfo(access_index)), ordering_rule_(ordering) {}
 };
@@ -63,6 +69,8 @@ class HazardDetectFirstUse {
                              QueueId queue_id) const {
         return pos->second.DetectAsyncHazard(recorded_use_, tag_range_, start_tag, queue_id);
     }
+    // Replays a whole recorded access, which can report any hazard type
+    SyncAccessIndex GetAccessIndex() const { return SYNC_ACCESS_INDEX_NONE; }
 
   private:
     const ResourceAccessState &recorded_use_;
@@ -86,6 +94,10 @@ AccessContext::AccessContext(uint32_t subpass, VkQueueFlags queue_flags,
         prev_by_subpass_[prev_pass] = &prev_.back();
     }
 
+    if (external_context) {
+        hazard_suppression_ = external_context->hazard_suppression_;
+    }
+
     async_.reserve(subpass_dep.async.size());
     for (const auto async_subpass : subpass_dep.async) {
         // Start tags are not known at creation time (as it's done at BeginRenderpass)
@@ -102,6 +114,74 @@ AccessContext::AccessContext(uint32_t subpass, VkQueueFlags queue_flags,
     }
 }
 
+AccessContext::AccessContext(const AccessContext &copy_from)
+    : prev_(copy_from.prev_),
+      prev_by_subpass_(copy_from.prev_by_subpass_),
+      async_(copy_from.async_),
+      src_external_(copy_from.src_external_),
+      dst_external_(copy_from.dst_external_),
+      start_tag_(copy_from.start_tag_) {
+    // Copies are kept as snapshots that may be read from other threads, so they never carry pending epochs
+    copy_from.ApplyGlobalBarrierEpochs();
+    access_state_map_ = copy_from.access_state_map_;
+}
+
+AccessContext &AccessContext::operator=(const AccessContext &copy_from) {
+    if (this == &copy_from) return *this;
+    // Same as the copy constructor, the hazard suppression of this context is kept
+    copy_from.ApplyGlobalBarrierEpochs();
+    access_state_map_ = copy_from.access_state_map_;
+    prev_ = copy_from.prev_;
+    prev_by_subpass_ = copy_from.prev_by_subpass_;
+    async_ = copy_from.async_;
+    src_external_ = copy_from.src_external_;
+    dst_external_ = copy_from.dst_external_;
+    start_tag_ = copy_from.start_tag_;
+    global_barrier_epochs_.clear();
+    fold_guard_.pending.store(false, std::memory_order_relaxed);
+    return *this;
+}
+
+void AccessContext::RecordGlobalBarriers(const std::vector<SyncBarrier> &barriers, ResourceUsageTag tag) {
+    if (global_barrier_epochs_.size() >= kMaxGlobalBarrierEpochs) {
+        ApplyGlobalBarrierEpochs();
+    }
+    global_barrier_epochs_.emplace_back(GlobalBarrierEpoch{barriers, tag});
+    fold_guard_.pending.store(true, std::memory_order_release);
+    if (syncval_telemetry::CountingWork()) syncval_telemetry::work_counters.barriers += barriers.size();
+}
+
+void AccessContext::FoldGlobalBarriers(ResourceAccessState &access) const {
+    const uint32_t pending_epochs = PendingBarrierEpochs();
+    if (access.FoldedBarrierEpochs() >= pending_epochs) return;
+    if (syncval_telemetry::CountingWork()) ++syncval_telemetry::work_counters.barrier_ranges;
+
+    // Same effect as the PipelineBarrierOp/ApplyBarrierOpsFunctor pair used for global barriers at submit time
+    const ResourceAccessState::QueueScopeOps scope(kQueueIdInvalid);
+    for (uint32_t i = access.FoldedBarrierEpochs(); i < pending_epochs; ++i) {
+        const GlobalBarrierEpoch &epoch = global_barrier_epochs_[i];
+        for (const SyncBarrier &barrier : epoch.barriers) {
+            access.ApplyBarrier(scope, barrier, false);
+        }
+        access.ApplyPendingBarriers(epoch.tag);
+    }
+    access.SetFoldedBarrierEpochs(pending_epochs);
+}
+
+void AccessContext::ApplyGlobalBarrierEpochs() const {
+    if (!fold_guard_.pending.load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> guard(fold_guard_.lock);
+    if (global_barrier_epochs_.empty()) return;  // Another reader folded everything while this one waited for the lock
+    auto &accesses = const_cast<ResourceAccessRangeMap &>(access_state_map_);
+    for (auto &access : accesses) {
+        FoldGlobalBarriers(access.second);
+        // Nothing is pending anymore, so every count starts over
+        access.second.SetFoldedBarrierEpochs(0);
+    }
+    global_barrier_epochs_.clear();
+    fold_guard_.pending.store(false, std::memory_order_release);
+}
+
 template <typename NormalizeOp>
 void AccessContext::Trim(NormalizeOp &&normalize) {
     ForAll(std::forward<NormalizeOp>(normalize));
@@ -128,6 +208,7 @@ void AccessContext::AddReferencedTags(ResourceUsageTagSet &used) const {
 
 template <typename Action>
 void AccessContext::ForAll(Action &&action) {
+    ApplyGlobalBarrierEpochs();
     for (auto &access : access_state_map_) {
         action(access);
     }
@@ -135,6 +216,7 @@ void AccessContext::ForAll(Action &&action) {
 
 template <typename Action>
 void AccessContext::ConstForAll(Action &&action) const {
+    ApplyGlobalBarrierEpochs();
     for (auto &access : access_state_map_) {
         action(access);
     }
@@ -142,6 +224,7 @@ void AccessContext::ConstForAll(Action &&action) const {
 
 void AccessContext::ResolveFromContext(const AccessContext &from) {
     const NoopBarrierAction noop_barrier;
+    ApplyGlobalBarrierEpochs();
     from.ResolveAccessRange(kFullRange, noop_barrier, &access_state_map_, nullptr);
 }
 
@@ -175,6 +258,7 @@ void AccessContext::ResolvePreviousAccesses() {
     ResourceAccessState default_state;
     if (!prev_.size()) return;  // If no previous contexts, nothing to do
 
+    ApplyGlobalBarrierEpochs();
     ResolvePreviousAccess(kFullRange, &access_state_map_, &default_state);
 }
 
@@ -188,7 +272,7 @@ void AccessContext::UpdateAccessState(const vvl::Buffer &buffer, SyncAccessIndex
     }
     const auto base_address = ResourceBaseAddress(buffer);
     UpdateMemoryAccessStateFunctor action(*this, current_usage, ordering_rule, tag_ex);
-    UpdateMemoryAccessRangeState(access_state_map_, action, range + base_address);
+    UpdateMemoryAccessRangeState(action, range + base_address);
 }
 
 void AccessContext::UpdateAccessState(const vvl::Image &image, SyncAccessIndex current_usage, SyncOrdering ordering_rule,
@@ -216,6 +300,16 @@ void AccessContext::UpdateAccessState(const vvl::ImageView &image_view, SyncAcce
 
 void AccessContext::UpdateAccessState(const vvl::ImageView &image_view, SyncAccessIndex current_usage, SyncOrdering ordering_rule,
                                       ResourceUsageTagEx tag_ex) {
+    const auto &view_sub_state = syncval_state::SubState(image_view);
+    if (view_sub_state.HasCachedRanges()) {
+        if (current_usage == SYNC_ACCESS_INDEX_NONE) {
+            return;
+        }
+        auto range_gen = view_sub_state.MakeCachedRangeGen();
+        UpdateMemoryAccessStateFunctor action(*this, current_usage, ordering_rule, tag_ex);
+        UpdateMemoryAccessState(action, range_gen);
+        return;
+    }
     auto range_gen = syncval_state::MakeImageRangeGen(image_view);
     UpdateAccessState(range_gen, current_usage, ordering_rule, tag_ex);
 }
@@ -256,6 +350,7 @@ void AccessContext::UpdateAccessState(const ImageRangeGen &range_gen, SyncAccess
 }
 
 void AccessContext::ResolveChildContexts(const std::vector<AccessContext> &contexts) {
+    ApplyGlobalBarrierEpochs();
     for (uint32_t subpass_index = 0; subpass_index < contexts.size(); subpass_index++) {
         auto &context = contexts[subpass_index];
         ApplyTrackbackStackAction barrier_action(context.GetDstExternalTrackBack().barriers);
@@ -341,6 +436,11 @@ HazardResult AccessContext::DetectHazard(const vvl::Image &image, SyncAccessInde
 HazardResult AccessContext::DetectHazard(const vvl::ImageView &image_view, SyncAccessIndex current_usage) const {
     // Get is const, but callee will copy
     HazardDetector detector(current_usage);
+    const auto &view_sub_state = syncval_state::SubState(image_view);
+    if (view_sub_state.HasCachedRanges()) {
+        auto range_gen = view_sub_state.MakeCachedRangeGen();
+        return DetectHazardGeneratedRanges(detector, range_gen, DetectOptions::kDetectAll);
+    }
     auto range_gen = syncval_state::MakeImageRangeGen(image_view);
     return DetectHazardGeneratedRanges(detector, range_gen, DetectOptions::kDetectAll);
 }
@@ -407,6 +507,7 @@ class BarrierHazardDetector {
         // Async barrier hazard detection can use the same path as the usage index is not IsRead, but is IsWrite
         return pos->second.DetectAsyncHazard(access_info_, start_tag, queue_id);
     }
+    SyncAccessIndex GetAccessIndex() const { return access_info_.access_index; }
 
   private:
     const SyncAccessInfo &access_info_;
@@ -465,6 +566,7 @@ class EventBarrierHazardDetector {
         // Async barrier hazard detection can use the same path as the usage index is not IsRead, but is IsWrite
         return pos->second.DetectAsyncHazard(access_info_, start_tag, queue_id);
     }
+    SyncAccessIndex GetAccessIndex() const { return access_info_.access_index; }
 
   private:
     bool ScopeInvalid() const { return scope_pos_ == scope_end_; }
@@ -539,7 +641,50 @@ void AccessContext::UpdateMemoryAccessStateFunctor::operator()(const ResourceAcc
 // This is called with the *recorded* command buffers access context, with the *active* access context pass in, againsts which
 // hazards will be detected
 HazardResult AccessContext::DetectFirstUseHazard(QueueId queue_id, const ResourceUsageRange &tag_range,
-                                                 const AccessContext &access_context) const {
+                                                 const AccessContext &access_context, vvl::ThreadPool *thread_pool) const {
+    ApplyGlobalBarrierEpochs();
+    // Below this the hand off to the workers costs more than the detection itself
+    constexpr uint32_t kFirstUseRangesPerChunk = 64;
+    if (thread_pool && thread_pool->MaxWorkers() > 0 && access_state_map_.size() > 2 * kFirstUseRangesPerChunk) {
+        std::vector<const ResourceAccessRangeMap::value_type *> recorded_accesses;
+        recorded_accesses.reserve(access_state_map_.size());
+        for (const auto &recorded_access : access_state_map_) {
+            if (recorded_access.second.FirstAccessInTagRange(tag_range)) {
+                recorded_accesses.emplace_back(&recorded_access);
+            }
+        }
+
+        // Chunks are runs of consecutive addresses. The serial walk reports the hazard at the lowest address, so the
+        // first chunk with a hazard wins and the result does not depend on how the chunks got scheduled.
+        const uint32_t recorded_count = static_cast<uint32_t>(recorded_accesses.size());
+        const uint32_t chunk_count = (recorded_count + kFirstUseRangesPerChunk - 1) / kFirstUseRangesPerChunk;
+        std::vector<HazardResult> chunk_hazards(chunk_count);
+        std::atomic<uint32_t> first_hazard_chunk{chunk_count};
+        thread_pool->ParallelFor(chunk_count, [&](uint32_t chunk) {
+            if (chunk > first_hazard_chunk.load()) return;  // An earlier chunk already has the hazard to report
+            const uint32_t end = std::min(recorded_count, (chunk + 1) * kFirstUseRangesPerChunk);
+            for (uint32_t i = chunk * kFirstUseRangesPerChunk; i < end; ++i) {
+                const auto &recorded_access = *recorded_accesses[i];
+                HazardDetectFirstUse detector(recorded_access.second, queue_id, tag_range);
+                HazardResult hazard = access_context.DetectHazardRange(detector, recorded_access.first, DetectOptions::kDetectAll);
+                if (hazard.IsHazard()) {
+                    chunk_hazards[chunk] = std::move(hazard);
+                    uint32_t current = first_hazard_chunk.load();
+                    while (chunk < current && !first_hazard_chunk.compare_exchange_weak(current, chunk)) {
+                    }
+                    return;
+                }
+            }
+        });
+
+        for (HazardResult &hazard : chunk_hazards) {
+            if (hazard.IsHazard()) {
+                return std::move(hazard);
+            }
+        }
+        return {};
+    }
+
     for (const auto &recorded_access : access_state_map_) {
         // Cull any entries not in the current tag range
         if (!recorded_access.second.FirstAccessInTagRange(tag_range)) continue;
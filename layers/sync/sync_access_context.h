@@ -19,6 +19,7 @@
 
 #include "sync/sync_common.h"
 #include "sync/sync_access_state.h"
+#include "sync/sync_telemetry.h"
 
 struct SubpassDependencyGraphNode;
 
@@ -28,6 +29,7 @@ class Buffer;
 class Event;
 class Image;
 class ImageView;
+class ThreadPool;
 class VideoPictureResource;
 class VideoSession;
 }  // namespace vvl
@@ -118,6 +120,7 @@ class ApplyBarrierOpsFunctor {
     }
 
     void operator()(const Iterator &pos) const {
+        if (syncval_telemetry::CountingWork()) ++syncval_telemetry::work_counters.barrier_ranges;
         auto &access_state = pos->second;
         for (const auto &op : barrier_ops_) {
             op(&access_state);
@@ -136,6 +139,7 @@ class ApplyBarrierOpsFunctor {
         barrier_ops_.reserve(size_hint);
     }
     void EmplaceBack(const BarrierOp &op) {
+        if (syncval_telemetry::CountingWork()) ++syncval_telemetry::work_counters.barriers;
         barrier_ops_.emplace_back(op);
         infill_default_ |= op.layout_transition;
     }
@@ -279,10 +283,14 @@ class AccessContext {
                                           DetectOptions options) const;
     HazardResult DetectSubpassTransitionHazard(const TrackBack &track_back, const AttachmentViewGen &attach_view) const;
 
-    HazardResult DetectFirstUseHazard(QueueId queue_id, const ResourceUsageRange &tag_range,
-                                      const AccessContext &access_context) const;
+    // When a thread pool is given, the recorded ranges may be checked on its workers. Only pass one if nothing else reads
+    // or folds barriers into access_context (or its async contexts) meanwhile.
+    HazardResult DetectFirstUseHazard(QueueId queue_id, const ResourceUsageRange &tag_range, const AccessContext &access_context,
+                                      vvl::ThreadPool *thread_pool = nullptr) const;
 
     const TrackBack &GetDstExternalTrackBack() const { return dst_external_; }
+    // Kept across Reset and not copied, as only record time contexts skip checks for suppressed hazards
+    void SetHazardSuppression(const HazardSuppression *hazard_suppression) { hazard_suppression_ = hazard_suppression; }
     void Reset() {
         prev_.clear();
         prev_by_subpass_.clear();
@@ -291,6 +299,8 @@ class AccessContext {
         dst_external_ = TrackBack();
         start_tag_ = ResourceUsageTag();
         access_state_map_.clear();
+        global_barrier_epochs_.clear();
+        fold_guard_.pending.store(false, std::memory_order_relaxed);
     }
 
     void ResolvePreviousAccesses();
@@ -335,13 +345,22 @@ class AccessContext {
                   const std::vector<AccessContext> &contexts, const AccessContext *external_context);
 
     AccessContext() { Reset(); }
-    AccessContext(const AccessContext &copy_from) = default;
+    AccessContext(const AccessContext &copy_from);
+    AccessContext(AccessContext &&) = default;
+    AccessContext &operator=(const AccessContext &copy_from);
+    AccessContext &operator=(AccessContext &&) = default;
     void Trim();
     void TrimAndClearFirstAccess();
     void AddReferencedTags(ResourceUsageTagSet &referenced) const;
 
-    ResourceAccessRangeMap &GetAccessStateMap() { return access_state_map_; }
-    const ResourceAccessRangeMap &GetAccessStateMap() const { return access_state_map_; }
+    ResourceAccessRangeMap &GetAccessStateMap() {
+        ApplyGlobalBarrierEpochs();
+        return access_state_map_;
+    }
+    const ResourceAccessRangeMap &GetAccessStateMap() const {
+        ApplyGlobalBarrierEpochs();
+        return access_state_map_;
+    }
     const TrackBack *GetTrackBackFromSubpass(uint32_t subpass) const {
         if (subpass == VK_SUBPASS_EXTERNAL) {
             return src_external_;
@@ -383,9 +402,49 @@ class AccessContext {
     template <typename Action, typename RangeGen>
     void UpdateMemoryAccessState(const Action &action, RangeGen &range_gen);
 
+    // Global memory barriers recorded into a command buffer are not applied to the whole map right away. Each one is kept
+    // as an epoch and folded into a range's state the next time that range is read or updated.
+    void RecordGlobalBarriers(const std::vector<SyncBarrier> &barriers, ResourceUsageTag tag);
+    // Folds every pending epoch into the map. Needed before the context is shared, e.g. once recording ends.
+    void ApplyGlobalBarrierEpochs() const;
+
   private:
     template <typename Action>
-    static void UpdateMemoryAccessRangeState(ResourceAccessRangeMap &accesses, Action &action, const ResourceAccessRange &range);
+    friend struct ActionToOpsAdapter;
+
+    // States count how many of the pending epochs were folded into them. The count is only meaningful within this context,
+    // so states resolved in from other contexts start over at zero, which is why that only happens with nothing pending.
+    struct GlobalBarrierEpoch {
+        std::vector<SyncBarrier> barriers;
+        ResourceUsageTag tag;
+    };
+    // Bounds the per-state fold cost, past this many pending epochs the whole map is folded at once
+    static constexpr size_t kMaxGlobalBarrierEpochs = 64;
+    static_assert(kMaxGlobalBarrierEpochs <= std::numeric_limits<uint8_t>::max(), "Must fit ResourceAccessState's count");
+
+    // Const readers fold pending epochs into the states they read, and may do so from several threads at once (e.g. the
+    // workers of DetectFirstUseHazard), so those folds are serialized. Every context has its own lock, copies and moves only
+    // carry over whether epochs are pending.
+    struct GlobalBarrierFoldGuard {
+        GlobalBarrierFoldGuard() = default;
+        GlobalBarrierFoldGuard(const GlobalBarrierFoldGuard &other) : pending(other.pending.load()) {}
+        GlobalBarrierFoldGuard &operator=(const GlobalBarrierFoldGuard &other) {
+            pending.store(other.pending.load());
+            return *this;
+        }
+
+        std::mutex lock;
+        // Set while global_barrier_epochs_ is not empty, so readers skip the lock when there is nothing to fold
+        std::atomic<bool> pending{false};
+    };
+
+    uint32_t PendingBarrierEpochs() const { return static_cast<uint32_t>(global_barrier_epochs_.size()); }
+    void FoldGlobalBarriers(ResourceAccessState &access) const;
+    template <typename RangeGen>
+    void FoldGlobalBarriersInRanges(RangeGen range_gen) const;
+
+    template <typename Action>
+    void UpdateMemoryAccessRangeState(Action &action, const ResourceAccessRange &range);
 
     struct UpdateMemoryAccessStateFunctor {
         using Iterator = ResourceAccessRangeMap::iterator;
@@ -457,6 +516,10 @@ class AccessContext {
     TrackBack *src_external_;
     TrackBack dst_external_;
     ResourceUsageTag start_tag_;
+    // Folding pending epochs doesn't change what the context describes, so const readers may do it under fold_guard_
+    mutable std::vector<GlobalBarrierEpoch> global_barrier_epochs_;
+    mutable GlobalBarrierFoldGuard fold_guard_;
+    const HazardSuppression *hazard_suppression_ = nullptr;
 };
 
 // The semantics of the InfillUpdateOps of infill_update_range are slightly different than for the UpdateMemoryAccessState Action
@@ -475,34 +538,56 @@ struct ActionToOpsAdapter {
 
         // Need to apply the action to the Infill.  'infill_update_range' expect ops.infill to be completely done with
         // the infill_range, where as Action::Infill assumes the caller will apply the action() logic to the infill_range
-        for (; infill != pos; ++infill) {
-            assert(infill != accesses.end());
+        // Note: pos itself may have been invalidated by the Infill, so walk by range instead of comparing against it
+        for (; infill != accesses.end() && infill->first.begin < infill_range.end; ++infill) {
+            // Infilled entries didn't exist when the pending global barriers were recorded
+            infill->second.SetFoldedBarrierEpochs(context.PendingBarrierEpochs());
             action(infill);
         }
     }
-    void update(const Iterator &pos) const { action(pos); }
+    void update(const Iterator &pos) const {
+        context.FoldGlobalBarriers(pos->second);
+        action(pos);
+    }
     const Action &action;
+    const AccessContext &context;
 };
 
 template <typename Action>
 void AccessContext::ApplyToContext(const Action &barrier_action) {
     // Note: Barriers do *not* cross context boundaries, applying to accessess within.... (at least for renderpass subpasses)
-    UpdateMemoryAccessRangeState(access_state_map_, barrier_action, kFullRange);
+    UpdateMemoryAccessRangeState(barrier_action, kFullRange);
 }
 
 template <typename Action>
-void AccessContext::UpdateMemoryAccessRangeState(ResourceAccessRangeMap &accesses, Action &action,
-                                                 const ResourceAccessRange &range) {
-    ActionToOpsAdapter<Action> ops{action};
-    infill_update_range(accesses, range, ops);
+void AccessContext::UpdateMemoryAccessRangeState(Action &action, const ResourceAccessRange &range) {
+    SingleRangeGenerator<ResourceAccessRange> range_gen(range);
+    ActionToOpsAdapter<Action> ops{action, *this};
+    infill_update_rangegen(access_state_map_, range_gen, ops);
 }
 
+// All generated ranges are applied in a single pass over the map, see infill_update_rangegen
 template <typename Action, typename RangeGen>
 void AccessContext::UpdateMemoryAccessState(const Action &action, RangeGen &range_gen) {
-    ActionToOpsAdapter<Action> ops{action};
+    ActionToOpsAdapter<Action> ops{action, *this};
     infill_update_rangegen(access_state_map_, range_gen, ops);
 }
 
+template <typename RangeGen>
+void AccessContext::FoldGlobalBarriersInRanges(RangeGen range_gen) const {
+    if (!fold_guard_.pending.load(std::memory_order_acquire)) return;
+    std::lock_guard<std::mutex> guard(fold_guard_.lock);
+    // Folding only rewrites values, never keys, so iterators held by the caller stay valid. Other readers only look at a
+    // state once they folded it under the lock, after which it isn't written again.
+    auto &accesses = const_cast<ResourceAccessRangeMap &>(access_state_map_);
+    for (; range_gen->non_empty(); ++range_gen) {
+        const ResourceAccessRange range = *range_gen;
+        for (auto pos = accesses.lower_bound(range); pos != accesses.end() && pos->first.begin < range.end; ++pos) {
+            FoldGlobalBarriers(pos->second);
+        }
+    }
+}
+
 template <typename Action>
 void AccessContext::ApplyUpdateAction(const AttachmentViewGen &view_gen, AttachmentViewGen::Gen gen_type, const Action &action) {
     const std::optional<ImageRangeGen> &ref_range_gen = view_gen.GetRangeGen(gen_type);
@@ -519,12 +604,14 @@ HazardResult AccessContext::DetectAsyncHazard(const Detector &detector, const Ra
     using RangeType = typename RangeGen::RangeType;
     using ConstIterator = ResourceAccessRangeMap::const_iterator;
     RangeGen range_gen(const_range_gen);
+    FoldGlobalBarriersInRanges(range_gen);
 
     HazardResult hazard;
 
     auto do_async_hazard_check = [&detector, async_tag, async_queue_id, &hazard](const RangeType &range, const ConstIterator &end,
                                                                                  ConstIterator &pos) {
         while (pos != end && pos->first.begin < range.end) {
+            if (syncval_telemetry::CountingWork()) ++syncval_telemetry::work_counters.hazard_ranges;
             hazard = detector.DetectAsync(pos, async_tag, async_queue_id);
             if (hazard.IsHazard()) return true;
             ++pos;
@@ -559,6 +646,7 @@ HazardResult AccessContext::DetectHazardOneRange(Detector &detector, bool detect
             gap.begin = pos->first.end;
         }
 
+        if (syncval_telemetry::CountingWork()) ++syncval_telemetry::work_counters.hazard_ranges;
         hazard = detector.Detect(pos);
         if (hazard.IsHazard()) return hazard;
         ++pos;
@@ -586,6 +674,7 @@ void AccessContext::ResolveAccessRange(const ResourceAccessRange &range, Barrier
                                        ResourceAccessRangeMap *resolve_map, const ResourceAccessState *infill_state,
                                        bool recur_to_infill) const {
     if (!range.non_empty()) return;
+    FoldGlobalBarriersInRanges(SingleRangeGenerator<ResourceAccessRange>(range));
 
     ResourceRangeMergeIterator current(*resolve_map, access_state_map_, range.begin);
     while (current->range.non_empty() && range.includes(current->range.begin)) {
@@ -593,6 +682,8 @@ void AccessContext::ResolveAccessRange(const ResourceAccessRange &range, Barrier
         if (current->pos_B->valid) {
             const auto &src_pos = current->pos_B->lower_bound;
             ResourceAccessState access(src_pos->second);  // intentional copy
+            // The fold count is relative to this context's epochs, not the ones of the map resolved into
+            access.SetFoldedBarrierEpochs(0);
             barrier_action(&access);
             if (current->pos_A->valid) {
                 const auto trimmed = sparse_container::split(current->pos_A->lower_bound, *resolve_map, current_range);
@@ -649,7 +740,15 @@ void AccessContext::ResolveAccessRange(const ResourceAccessRange &range, Barrier
 // the DAG of the contexts (for example subpasses)
 template <typename Detector, typename RangeGen>
 HazardResult AccessContext::DetectHazardGeneratedRanges(Detector &detector, RangeGen &range_gen, DetectOptions options) const {
+    if (syncval_telemetry::CountingWork()) ++syncval_telemetry::work_counters.hazard_checks;
+    if (hazard_suppression_) {
+        const bool detect_async = (static_cast<uint32_t>(options) & DetectOptions::kDetectAsync) && !async_.empty();
+        if (hazard_suppression_->CanSkip(detector.GetAccessIndex(), detect_async)) {
+            return {};
+        }
+    }
     HazardResult hazard;
+    FoldGlobalBarriersInRanges(range_gen);
 
     // Do this before range_gen is incremented s.t. the copies used will be correct
     if (static_cast<uint32_t>(options) & DetectOptions::kDetectAsync) {
@@ -682,6 +781,7 @@ HazardResult AccessContext::DetectPreviousHazard(Detector &detector, const Resou
     ResolvePreviousAccess(range, &descent_map, nullptr);
 
     for (auto prev = descent_map.begin(); prev != descent_map.end(); ++prev) {
+        if (syncval_telemetry::CountingWork()) ++syncval_telemetry::work_counters.hazard_ranges;
         HazardResult hazard = detector.Detect(prev);
         if (hazard.IsHazard()) {
             return hazard;
@@ -693,18 +793,21 @@ HazardResult AccessContext::DetectPreviousHazard(Detector &detector, const Resou
 template <typename Predicate>
 void AccessContext::EraseIf(Predicate &&pred) {
     // Note: Don't forward, we don't want r-values moved, since we're going to make multiple calls.
+    ApplyGlobalBarrierEpochs();
     vvl::EraseIf(access_state_map_, pred);
 }
 
 template <typename ResolveOp>
 void AccessContext::ResolveFromContext(ResolveOp &&resolve_op, const AccessContext &from_context,
                                        const ResourceAccessState *infill_state, bool recur_to_infill) {
+    ApplyGlobalBarrierEpochs();
     from_context.ResolveAccessRange(kFullRange, resolve_op, &access_state_map_, infill_state, recur_to_infill);
 }
 
 template <typename ResolveOp, typename RangeGenerator>
 void AccessContext::ResolveFromContext(ResolveOp &&resolve_op, const AccessContext &from_context, RangeGenerator range_gen,
                                        const ResourceAccessState *infill_state, bool recur_to_infill) {
+    ApplyGlobalBarrierEpochs();
     for (; range_gen->non_empty(); ++range_gen) {
         from_context.ResolveAccessRange(*range_gen, resolve_op, &access_state_map_, infill_state, recur_to_infill);
     }
@@ -123,7 +123,7 @@ HazardResult ResourceAccessState::DetectHazard(const SyncAccessInfo &usage_info,
             // If we're tracking any reads that aren't ordered against the current write, got to check 'em all.
             if ((ordered_stages & last_read_stages) != last_read_stages) {
                 for (const auto &read_access : last_reads) {
-                    if (read_access.stage & ordered_stages) continue;  // but we can skip the ordered ones
+                    if (read_access.Stage() & ordered_stages) continue;  // but we can skip the ordered ones
                     if (IsReadHazard(usage_stage, read_access)) {
                         return HazardResult::HazardVsPriorRead(this, usage_info, WRITE_AFTER_READ, read_access);
                     }
@@ -292,7 +292,7 @@ HazardResult ResourceAccessState::DetectBarrierHazard(const SyncAccessInfo &usag
             for (ReadStates::size_type read_idx = 0; read_idx < scope_read_count; ++read_idx) {
                 const ReadState &scope_read = scope_reads[read_idx];
                 const ReadState &current_read = last_reads[read_idx];
-                assert(scope_read.stage == current_read.stage);
+                assert(scope_read.Stage() == current_read.Stage());
                 if (current_read.tag > event_tag) {
                     // The read is more recent than the set event scope, thus no barrier from the wait/ILT.
                     return HazardResult::HazardVsPriorRead(this, usage_info, WRITE_AFTER_READ, current_read);
@@ -332,16 +332,16 @@ void ResourceAccessState::MergeReads(const ResourceAccessState &other) {
     const auto pre_merge_stages = last_read_stages;
     for (uint32_t other_read_index = 0; other_read_index < other.last_reads.size(); other_read_index++) {
         auto &other_read = other.last_reads[other_read_index];
-        if (pre_merge_stages & other_read.stage) {
+        if (pre_merge_stages & other_read.Stage()) {
             // Merge in the barriers for read stages that exist in *both* this and other
             // TODO: This is N^2 with stages... perhaps the ReadStates should be sorted by stage index.
             //       but we should wait on profiling data for that.
             for (uint32_t my_read_index = 0; my_read_index < pre_merge_count; my_read_index++) {
                 auto &my_read = last_reads[my_read_index];
-                if (other_read.stage == my_read.stage) {
+                if (other_read.Stage() == my_read.Stage()) {
                     if (my_read.tag < other_read.tag) {
                         // Other is more recent, copy in the state
-                        my_read.access_index = other_read.access_index;
+                        my_read.access = other_read.access;
                         my_read.tag = other_read.tag;
                         my_read.handle_index = other_read.handle_index;
                         my_read.queue = other_read.queue;
@@ -350,7 +350,7 @@ void ResourceAccessState::MergeReads(const ResourceAccessState &other) {
                         //                  May require tracking more than one access per stage.
                         my_read.barriers = other_read.barriers;
                         my_read.sync_stages = other_read.sync_stages;
-                        if (my_read.stage == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT) {
+                        if (my_read.Stage() == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT) {
                             // Since I'm overwriting the fragement stage read, also update the input attachment info
                             // as this is the only stage that affects it.
                             input_attachment_read = other.input_attachment_read;
@@ -368,8 +368,8 @@ void ResourceAccessState::MergeReads(const ResourceAccessState &other) {
         } else {
             // The other read stage doesn't exist in this, so add it.
             last_reads.emplace_back(other_read);
-            last_read_stages |= other_read.stage;
-            if (other_read.stage == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT) {
+            last_read_stages |= other_read.Stage();
+            if (other_read.Stage() == VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT) {
                 input_attachment_read = other.input_attachment_read;
             }
         }
@@ -450,12 +450,12 @@ void ResourceAccessState::Update(const SyncAccessInfo &usage_info, SyncOrdering
         if (usage_stage & last_read_stages) {
             const auto not_usage_stage = ~usage_stage;
             for (auto &read_access : last_reads) {
-                if (read_access.stage == usage_stage) {
+                if (read_access.Stage() == usage_stage) {
                     // TODO: having Set here instead of constructor makes measurable performance difference.
                     // With MSVC compiler for doom capture using constructor results in: 4.8 fps -> 4.0 fps.
                     // When the entire system is more optimized there should be no sensitivity to such changes
                     // (more POD objects), and the Set method should be removed.
-                    read_access.Set(usage_stage, usage_info.access_index, tag_ex);
+                    read_access.Set(usage_info, tag_ex);
                 } else if (read_access.barriers & usage_stage) {
                     // If the current access is barriered to this stage, mark it as "known to happen after"
                     read_access.sync_stages |= usage_stage;
@@ -472,7 +472,7 @@ void ResourceAccessState::Update(const SyncAccessInfo &usage_info, SyncOrdering
                     read_access.sync_stages |= usage_stage;
                 }
             }
-            last_reads.emplace_back(usage_stage, usage_info.access_index, tag_ex);
+            last_reads.emplace_back(usage_info, tag_ex);
             last_read_stages |= usage_stage;
         }
 
@@ -498,9 +498,9 @@ HazardResult HazardResult::HazardVsPriorWrite(const ResourceAccessState *access_
 
 HazardResult HazardResult::HazardVsPriorRead(const ResourceAccessState *access_state, const SyncAccessInfo &usage_info,
                                              SyncHazard hazard, const ReadState &prior_read) {
-    assert(prior_read.access_index != SYNC_ACCESS_INDEX_NONE);
+    assert(prior_read.AccessIndex() != SYNC_ACCESS_INDEX_NONE);
     HazardResult result;
-    result.state_.emplace(access_state, usage_info, hazard, prior_read.access_index, prior_read.TagEx());
+    result.state_.emplace(access_state, usage_info, hazard, prior_read.AccessIndex(), prior_read.TagEx());
     return result;
 }
 
@@ -599,7 +599,7 @@ void ResourceAccessState::ApplySemaphore(const SemaphoreScope &signal, const Sem
 // Read access predicate for queue wait
 bool ResourceAccessState::WaitQueueTagPredicate::operator()(const ReadState &read_access) const {
     return (read_access.queue == queue) && (read_access.tag <= tag) &&
-           (read_access.stage != VK_PIPELINE_STAGE_2_PRESENT_ENGINE_BIT_SYNCVAL);
+           (read_access.Stage() != VK_PIPELINE_STAGE_2_PRESENT_ENGINE_BIT_SYNCVAL);
 }
 bool ResourceAccessState::WaitQueueTagPredicate::operator()(const ResourceAccessState &access) const {
     if (!access.last_write.has_value()) return false;
@@ -610,7 +610,7 @@ bool ResourceAccessState::WaitQueueTagPredicate::operator()(const ResourceAccess
 
 // Read access predicate for queue wait
 bool ResourceAccessState::WaitTagPredicate::operator()(const ReadState &read_access) const {
-    return (read_access.tag <= tag) && (read_access.stage != VK_PIPELINE_STAGE_2_PRESENT_ENGINE_BIT_SYNCVAL);
+    return (read_access.tag <= tag) && (read_access.Stage() != VK_PIPELINE_STAGE_2_PRESENT_ENGINE_BIT_SYNCVAL);
 }
 bool ResourceAccessState::WaitTagPredicate::operator()(const ResourceAccessState &access) const {
     if (!access.last_write.has_value()) return false;
@@ -620,7 +620,7 @@ bool ResourceAccessState::WaitTagPredicate::operator()(const ResourceAccessState
 
 // Present operations only matching only the *exactly* tagged present and acquire operations
 bool ResourceAccessState::WaitAcquirePredicate::operator()(const ReadState &read_access) const {
-    return (read_access.tag == acquire_tag) && (read_access.stage == VK_PIPELINE_STAGE_2_PRESENT_ENGINE_BIT_SYNCVAL);
+    return (read_access.tag == acquire_tag) && (read_access.Stage() == VK_PIPELINE_STAGE_2_PRESENT_ENGINE_BIT_SYNCVAL);
 }
 bool ResourceAccessState::WaitAcquirePredicate::operator()(const ResourceAccessState &access) const {
     if (!access.last_write.has_value()) return false;
@@ -652,14 +652,14 @@ ResourceAccessState::ResourceAccessState()
       last_reads(),
       input_attachment_read(false),
       pending_layout_transition(false),
+      first_access_closed_(false),
       first_accesses_(),
       first_read_stages_(VK_PIPELINE_STAGE_2_NONE),
-      first_write_layout_ordering_(),
-      first_access_closed_(false) {}
+      first_write_layout_ordering_() {}
 
 VkPipelineStageFlags2 ResourceAccessState::GetReadBarriers(SyncAccessIndex access_index) const {
     for (const auto &read_access : last_reads) {
-        if (read_access.access_index == access_index) {
+        if (read_access.AccessIndex() == access_index) {
             return read_access.barriers;
         }
     }
@@ -695,7 +695,7 @@ bool ResourceAccessState::WriteInEventScope(VkPipelineStageFlags2 src_exec_scope
 }
 
 // As ReadStates must be unique by stage, this is as good a sort as needed
-bool operator<(const ReadState &lhs, const ReadState &rhs) { return lhs.stage < rhs.stage; }
+bool operator<(const ReadState &lhs, const ReadState &rhs) { return lhs.Stage() < rhs.Stage(); }
 
 void ResourceAccessState::Normalize() {
     std::sort(last_reads.begin(), last_reads.end());
@@ -729,7 +729,7 @@ VkPipelineStageFlags2 ResourceAccessState::GetOrderedStages(QueueId queue_id, co
     if (queue_id != kQueueIdInvalid) {
         for (const auto &read_access : last_reads) {
             if (read_access.queue != queue_id) {
-                non_qso_stages |= read_access.stage;
+                non_qso_stages |= read_access.Stage();
             }
         }
     }
@@ -775,14 +775,22 @@ void ResourceAccessState::TouchupFirstForLayoutTransition(ResourceUsageTag tag,
     }
 }
 
-ReadState::ReadState(VkPipelineStageFlags2 stage, SyncAccessIndex access_index, ResourceUsageTagEx tag_ex) {
-    Set(stage, access_index, tag_ex);
+size_t ResourceAccessState::HeapSize() const {
+    size_t size = 0;
+    if (last_reads.capacity() > ReadStates::kSmallCapacity) {
+        size += last_reads.capacity() * sizeof(ReadState);
+    }
+    if (first_accesses_.capacity() > FirstAccesses::kSmallCapacity) {
+        size += first_accesses_.capacity() * sizeof(ResourceFirstAccess);
+    }
+    return size;
 }
 
-void ReadState::Set(VkPipelineStageFlags2 stage, SyncAccessIndex access_index, ResourceUsageTagEx tag_ex) {
-    assert(access_index != SYNC_ACCESS_INDEX_NONE);
-    this->stage = stage;
-    this->access_index = access_index;
+ReadState::ReadState(const SyncAccessInfo &usage_info, ResourceUsageTagEx tag_ex) { Set(usage_info, tag_ex); }
+
+void ReadState::Set(const SyncAccessInfo &usage_info, ResourceUsageTagEx tag_ex) {
+    assert(usage_info.access_index != SYNC_ACCESS_INDEX_NONE);
+    access = &usage_info;
     barriers = VK_PIPELINE_STAGE_2_NONE;
     sync_stages = VK_PIPELINE_STAGE_2_NONE;
     tag = tag_ex.tag;
@@ -795,7 +803,7 @@ void ReadState::Set(VkPipelineStageFlags2 stage, SyncAccessIndex access_index, R
 // considered to be in "queue submission order" with barriers, events, or semaphore signalling, but any barriers
 // that have bee applied (via semaphore) to those accesses can be chained off of.
 bool ReadState::ReadInQueueScopeOrChain(QueueId scope_queue, VkPipelineStageFlags2 exec_scope) const {
-    VkPipelineStageFlags2 effective_stages = barriers | ((scope_queue == queue) ? stage : VK_PIPELINE_STAGE_2_NONE);
+    VkPipelineStageFlags2 effective_stages = barriers | ((scope_queue == queue) ? Stage() : VK_PIPELINE_STAGE_2_NONE);
     return (exec_scope & effective_stages) != 0;
 }
 
@@ -1061,6 +1069,34 @@ const char *string_SyncHazardVUID(SyncHazard hazard) {
     return "SYNC-HAZARD-INVALID";
 }
 
+void HazardSuppression::CountReport(SyncHazard hazard, uint32_t limit) {
+    if (limit == 0 || hazard == SyncHazard::NONE || hazard >= kHazardCount) {
+        return;
+    }
+    if (report_counts_[hazard].fetch_add(1, std::memory_order_relaxed) + 1 >= limit) {
+        Suppress(hazard);
+    }
+}
+
+bool HazardSuppression::CanSkip(SyncAccessIndex access_index, bool detect_async) const {
+    if (access_index == SYNC_ACCESS_INDEX_NONE) {
+        return false;
+    }
+    uint32_t reportable = 0;
+    if (SyncStageAccess::IsRead(access_index)) {
+        reportable = HazardBit(READ_AFTER_WRITE);
+        if (detect_async) {
+            reportable |= HazardBit(READ_RACING_WRITE);
+        }
+    } else {
+        reportable = HazardBit(WRITE_AFTER_READ) | HazardBit(WRITE_AFTER_WRITE);
+        if (detect_async) {
+            reportable |= HazardBit(WRITE_RACING_WRITE) | HazardBit(WRITE_RACING_READ);
+        }
+    }
+    return (suppressed_mask_.load(std::memory_order_relaxed) & reportable) == reportable;
+}
+
 SyncHazardInfo GetSyncHazardInfo(SyncHazard hazard) {
     switch (hazard) {
         case SyncHazard::NONE:
@@ -18,6 +18,8 @@
 #pragma once
 #include "sync/sync_common.h"
 
+#include <atomic>
+
 class ResourceAccessState;
 class WriteState;
 struct ReadState;
@@ -78,6 +80,28 @@ struct SyncHazardInfo {
 };
 SyncHazardInfo GetSyncHazardInfo(SyncHazard hazard);
 
+// Hazard types whose messages can no longer reach the application, either because the VUID is in message_id_filter or
+// because duplicate_message_limit was reached. The limit is counted per VUID by the logger, so suppression is per
+// hazard type too. Record time hazard checks that could only report suppressed hazards are skipped.
+class HazardSuppression {
+  public:
+    void Suppress(SyncHazard hazard) { suppressed_mask_.fetch_or(HazardBit(hazard), std::memory_order_relaxed); }
+
+    // Counts a reported hazard. It becomes suppressed once limit reports were made, zero limit never suppresses.
+    void CountReport(SyncHazard hazard, uint32_t limit);
+
+    // True when every hazard an access of access_index can report is suppressed. Present hazards are not considered as
+    // command buffer contexts never contain presentation accesses.
+    bool CanSkip(SyncAccessIndex access_index, bool detect_async) const;
+
+  private:
+    static constexpr uint32_t kHazardCount = SyncHazard::PRESENT_AFTER_WRITE + 1;
+    static constexpr uint32_t HazardBit(SyncHazard hazard) { return 1u << static_cast<uint32_t>(hazard); }
+
+    std::atomic<uint32_t> suppressed_mask_{0};
+    std::atomic<uint32_t> report_counts_[kHazardCount] = {};
+};
+
 class HazardResult {
   public:
     struct HazardState {
@@ -220,38 +244,41 @@ using ResourceUsageTagSet = CachedInsertSet<ResourceUsageTag, 4>;
 // but only up to one per pipeline stage (as another read from the *same* stage become more recent,
 // and applicable one for hazard detection
 struct ReadState {
-    VkPipelineStageFlags2 stage;        // The stage of this read
-    SyncAccessIndex access_index;       // TODO: Revisit whether this needs to support multiple reads per stage
+    // Stage and access index of this read. Pointing into the access info table keeps ReadState (and the inline ReadStates
+    // of every ResourceAccessState) a word smaller than storing both.
+    // TODO: Revisit whether this needs to support multiple reads per stage
+    const SyncAccessInfo *access;
     VkPipelineStageFlags2 barriers;     // all applicable barriered stages
     VkPipelineStageFlags2 sync_stages;  // reads known to have happened after this
     ResourceUsageTag tag;
-    uint32_t handle_index;
-    QueueId queue;
     VkPipelineStageFlags2 pending_dep_chain;  // Should be zero except during barrier application
                                               // Excluded from comparison
+    uint32_t handle_index;
+    QueueId queue;
     ReadState() = default;
-    ReadState(VkPipelineStageFlags2 stage, SyncAccessIndex access_index, ResourceUsageTagEx tag_ex);
-    void Set(VkPipelineStageFlags2 stage, SyncAccessIndex access_index, ResourceUsageTagEx tag_ex);
+    ReadState(const SyncAccessInfo &usage_info, ResourceUsageTagEx tag_ex);
+    void Set(const SyncAccessInfo &usage_info, ResourceUsageTagEx tag_ex);
 
+    VkPipelineStageFlags2 Stage() const { return access->stage_mask; }
+    SyncAccessIndex AccessIndex() const { return access->access_index; }
     ResourceUsageTagEx TagEx() const { return {tag, handle_index}; }
     bool operator==(const ReadState &rhs) const {
-        return (stage == rhs.stage) && (access_index == rhs.access_index) && (barriers == rhs.barriers) &&
-               (sync_stages == rhs.sync_stages) && (tag == rhs.tag) && (queue == rhs.queue) &&
-               (pending_dep_chain == rhs.pending_dep_chain);
+        return (access == rhs.access) && (barriers == rhs.barriers) && (sync_stages == rhs.sync_stages) && (tag == rhs.tag) &&
+               (queue == rhs.queue) && (pending_dep_chain == rhs.pending_dep_chain);
     }
     void Normalize() { pending_dep_chain = VK_PIPELINE_STAGE_2_NONE; }
     bool IsReadBarrierHazard(VkPipelineStageFlags2 src_exec_scope) const {
         // If the read stage is not in the src sync scope
         // *AND* not execution chained with an existing sync barrier (that's the or)
         // then the barrier access is unsafe (R/W after R)
-        return (src_exec_scope & (stage | barriers)) == 0;
+        return (src_exec_scope & (Stage() | barriers)) == 0;
     }
     bool IsReadBarrierHazard(QueueId barrier_queue, VkPipelineStageFlags2 src_exec_scope,
                              const SyncAccessFlags &src_access_scope) const {
         // If the read stage is not in the src sync scope
         // *AND* not execution chained with an existing sync barrier (that's the or)
         // then the barrier access is unsafe (R/W after R)
-        VkPipelineStageFlags2 queue_ordered_stage = (queue == barrier_queue) ? stage : VK_PIPELINE_STAGE_2_NONE;
+        VkPipelineStageFlags2 queue_ordered_stage = (queue == barrier_queue) ? Stage() : VK_PIPELINE_STAGE_2_NONE;
 
         // Current implementation relies on TOP_OF_PIPE constant due to the fact that it's non-zero value
         // and AND-ing with it can create execution dependency when it's necessary. When NONE constant is
@@ -268,7 +295,7 @@ struct ReadState {
 
         return (src_exec_scope & (queue_ordered_stage | barriers)) == 0;
     }
-    bool ReadInScopeOrChain(VkPipelineStageFlags2 exec_scope) const { return (exec_scope & (stage | barriers)) != 0; }
+    bool ReadInScopeOrChain(VkPipelineStageFlags2 exec_scope) const { return (exec_scope & (Stage() | barriers)) != 0; }
     bool ReadInQueueScopeOrChain(QueueId queue, VkPipelineStageFlags2 exec_scope) const;
     bool ReadInEventScope(VkPipelineStageFlags2 exec_scope, QueueId scope_queue, ResourceUsageTag scope_tag) const {
         // If this read is the same one we included in the set event and in scope, then apply the execution barrier...
@@ -413,6 +440,18 @@ class ResourceAccessState : public SyncStageAccess {
     SyncAccessIndex LastWriteOp() const { return last_write.has_value() ? last_write->Index() : SYNC_ACCESS_INDEX_NONE; }
     bool IsLastWriteOp(SyncAccessIndex access_index) const { return LastWriteOp() == access_index; }
     ResourceUsageTag LastWriteTag() const { return last_write.has_value() ? last_write->Tag() : ResourceUsageTag(0); }
+
+    // How many of the global barrier epochs pending in the owning record time context were already folded into this state,
+    // see AccessContext::GlobalBarrierEpoch. Bookkeeping only, so it isn't compared.
+    uint32_t FoldedBarrierEpochs() const { return folded_barrier_epochs_; }
+    void SetFoldedBarrierEpochs(uint32_t count) {
+        assert(count <= std::numeric_limits<uint8_t>::max());
+        folded_barrier_epochs_ = static_cast<uint8_t>(count);
+    }
+
+    // Heap memory owned by the read and first access lists once they outgrow their inline storage
+    size_t HeapSize() const;
+
     bool operator==(const ResourceAccessState &rhs) const {
         const bool write_same = (read_execution_barriers == rhs.read_execution_barriers) &&
                                 (input_attachment_read == rhs.input_attachment_read) && (last_write == rhs.last_write);
@@ -524,16 +563,24 @@ class ResourceAccessState : public SyncStageAccess {
     // Not part of the write state, logically.  Can exist when !last_write
     // Pending execution state to support independent parallel barriers
     bool pending_layout_transition;
+    // Kept with the other flags rather than the first access state below, so it packs into the padding before the index
+    bool first_access_closed_;
+    // Takes the last byte of that padding, so contexts that never defer global barriers don't pay for it
+    uint8_t folded_barrier_epochs_ = 0;
     uint32_t pending_layout_transition_handle_index = vvl::kNoIndex32;
 
     FirstAccesses first_accesses_;
     VkPipelineStageFlags2 first_read_stages_;
     OrderingBarrier first_write_layout_ordering_;
-    bool first_access_closed_;
 
     static OrderingBarriers kOrderingRules;
 };
 using ResourceAccessStateFunction = std::function<void(ResourceAccessState *)>;
+
+// Not a btree_range_map: with values this large a B-tree node only holds a few entries, which takes more memory per range
+// than std::map nodes and is slower for maps with few ranges per resource
+// One map over the fake device address space instead of per resource maps, so aliased resources see each other's accesses.
+// Sharding it by address window didn't make hazard checks consistently faster either.
 using ResourceAccessRangeMap = sparse_container::range_map<ResourceAddress, ResourceAccessState>;
 using ResourceRangeMergeIterator = sparse_container::parallel_iterator<ResourceAccessRangeMap, const ResourceAccessRangeMap>;
 
@@ -573,12 +620,12 @@ void ResourceAccessState::ApplyBarrier(ScopeOps &&scope, const SyncBarrier &barr
                 // scope
                 if (scope.ReadInScope(barrier, read_access)) {
                     // We'll apply the barrier in the next loop, because it's DRY'r to do it one place.
-                    stages_in_scope |= read_access.stage;
+                    stages_in_scope |= read_access.Stage();
                 }
             }
 
             for (auto &read_access : last_reads) {
-                if (0 != ((read_access.stage | read_access.sync_stages) & stages_in_scope)) {
+                if (0 != ((read_access.Stage() | read_access.sync_stages) & stages_in_scope)) {
                     // If this stage, or any stage known to be synchronized after it are in scope, apply the barrier to this
                     // read NOTE: Forwarding barriers to known prior stages changes the sync_stages from shallow to deep,
                     // because the
@@ -600,7 +647,7 @@ bool ResourceAccessState::ApplyPredicatedWait(Predicate &predicate) {
     for (auto &read_access : last_reads) {
         if (predicate(read_access)) {
             // If we know this stage is before any stage we syncing, or if the predicate tells us that we are waited for..
-            sync_reads |= read_access.stage;
+            sync_reads |= read_access.Stage();
         }
     }
 
@@ -608,9 +655,9 @@ bool ResourceAccessState::ApplyPredicatedWait(Predicate &predicate) {
     // NOTE: sync_stages is "deep" catching all stages synchronized after it because we forward barriers
     uint32_t unsync_count = 0;
     for (auto &read_access : last_reads) {
-        if (0 != ((read_access.stage | read_access.sync_stages) & sync_reads)) {
+        if (0 != ((read_access.Stage() | read_access.sync_stages) & sync_reads)) {
             // This is redundant in the "stage" case, but avoids a second branch to get an accurate count
-            sync_reads |= read_access.stage;
+            sync_reads |= read_access.Stage();
         } else {
             ++unsync_count;
         }
@@ -623,9 +670,9 @@ bool ResourceAccessState::ApplyPredicatedWait(Predicate &predicate) {
             unsync_reads.reserve(unsync_count);
             VkPipelineStageFlags2 unsync_read_stages = VK_PIPELINE_STAGE_2_NONE;
             for (auto &read_access : last_reads) {
-                if (0 == (read_access.stage & sync_reads)) {
+                if (0 == (read_access.Stage() & sync_reads)) {
                     unsync_reads.emplace_back(read_access);
-                    unsync_read_stages |= read_access.stage;
+                    unsync_read_stages |= read_access.Stage();
                 }
             }
             last_read_stages = unsync_read_stages;
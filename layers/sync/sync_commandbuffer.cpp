@@ -87,7 +87,9 @@ CommandBufferAccessContext::CommandBufferAccessContext(const SyncValidator &sync
       events_context_(),
       render_pass_contexts_(),
       current_renderpass_context_(),
-      sync_ops_() {}
+      sync_ops_() {
+    cb_access_context_.SetHazardSuppression(&sync_validator.hazard_suppression);
+}
 
 CommandBufferAccessContext::CommandBufferAccessContext(SyncValidator &sync_validator, vvl::CommandBuffer *cb_state)
     : CommandBufferAccessContext(sync_validator, cb_state->GetQueueFlags()) {
@@ -128,6 +130,7 @@ CommandBufferAccessContext::~CommandBufferAccessContext() {
 
 void CommandBufferAccessContext::Reset() {
     access_log_ = std::make_shared<AccessLog>();
+    compact_access_log_.reset();
     cbs_referenced_ = std::make_shared<CommandBufferSet>();
     if (cb_state_) {
         cbs_referenced_->push_back(cb_state_->shared_from_this());
@@ -148,6 +151,29 @@ void CommandBufferAccessContext::Reset() {
     dynamic_rendering_info_.reset();
 }
 
+void CommandBufferAccessContext::End() {
+    const bool telemetry_enabled = sync_state_.telemetry.Enabled();
+    syncval_telemetry::AccessStateMapSizes access_state_maps;
+    cb_access_context_.ApplyGlobalBarrierEpochs();
+    if (telemetry_enabled) {
+        access_state_maps.Add(cb_access_context_.GetAccessStateMap());
+    }
+    for (const auto &render_pass_context : render_pass_contexts_) {
+        for (const AccessContext &subpass_context : render_pass_context->GetContexts()) {
+            subpass_context.ApplyGlobalBarrierEpochs();
+            if (telemetry_enabled) {
+                access_state_maps.Add(subpass_context.GetAccessStateMap());
+            }
+        }
+    }
+    sync_state_.telemetry.AddCommandBuffer(access_state_maps, access_log_->size());
+
+    // Only primary command buffers are submitted
+    if (cb_state_ && cb_state_->IsPrimary()) {
+        compact_access_log_ = MakeCompactAccessLog();
+    }
+}
+
 bool CommandBufferAccessContext::ValidateBeginRendering(const ErrorObject &error_obj,
                                                         syncval_state::BeginRenderingCmdState &cmd_state) const {
     bool skip = false;
@@ -1188,6 +1214,57 @@ std::string CommandBufferAccessContext::GetDebugRegionName(const ResourceUsageRe
     return vvl::CommandBuffer::GetDebugRegionName(label_commands, record.label_command_index);
 }
 
+std::shared_ptr<const CompactAccessLog> CommandBufferAccessContext::MakeCompactAccessLog() const {
+    std::vector<AccessLogCodec::RunKey> runs;
+    const CompactAccessLog::Body body = CompactAccessLog::Encode(*access_log_, runs);
+    return std::make_shared<CompactAccessLog>(sync_state_.access_log_cache.LookUp(body, body), std::move(runs));
+}
+
+std::shared_ptr<const CompactAccessLog> CommandBufferAccessContext::GetCompactAccessLog() const {
+    if (compact_access_log_ && compact_access_log_->Size() == access_log_->size()) {
+        return compact_access_log_;
+    }
+    // Submitted without vkEndCommandBuffer, or recorded into after it. Don't cache, other threads may be reading this context.
+    return MakeCompactAccessLog();
+}
+
+void AccessLogCodec::EncodeRecord(const Record &record, State &state, std::vector<uint8_t> &bytes) {
+    static_assert(uint32_t(ResourceUsageRecord::SubcommandType::kIndex) < 8);
+    assert(!record.alt_usage);
+    vvl::EncodeVarint((uint64_t(record.command) << 3) | uint64_t(record.sub_command_type), bytes);
+    vvl::EncodeVarint(vvl::EncodeDelta(record.seq_num, state.seq_num), bytes);
+    state.seq_num = record.seq_num;
+
+    // Commands usually reference the handles right after the previous command's ones, subcommands the same ones
+    const uint32_t first_handle = record.first_handle_index + 1;
+    vvl::EncodeVarint(vvl::EncodeDelta(first_handle, state.handle_end), bytes);
+    vvl::EncodeVarint(record.handle_count, bytes);
+    if (first_handle != 0) {
+        state.handle_end = first_handle + record.handle_count;
+    }
+
+    const uint32_t label_command = record.label_command_index + 1;
+    vvl::EncodeVarint(vvl::EncodeDelta(label_command, state.label_command), bytes);
+    state.label_command = label_command;
+}
+
+void AccessLogCodec::DecodeRecord(const uint8_t *&data, State &state, Record &record) {
+    const uint64_t command = vvl::DecodeVarint(data);
+    record.command = static_cast<vvl::Func>(command >> 3);
+    record.sub_command_type = static_cast<ResourceUsageRecord::SubcommandType>(command & 0x7);
+    record.seq_num = state.seq_num = vvl::DecodeDelta(static_cast<uint32_t>(vvl::DecodeVarint(data)), state.seq_num);
+
+    const uint32_t first_handle = vvl::DecodeDelta(static_cast<uint32_t>(vvl::DecodeVarint(data)), state.handle_end);
+    record.first_handle_index = first_handle - 1;
+    record.handle_count = static_cast<uint32_t>(vvl::DecodeVarint(data));
+    if (first_handle != 0) {
+        state.handle_end = first_handle + record.handle_count;
+    }
+
+    state.label_command = vvl::DecodeDelta(static_cast<uint32_t>(vvl::DecodeVarint(data)), state.label_command);
+    record.label_command_index = state.label_command - 1;
+}
+
 void CommandBufferAccessContext::RecordSyncOp(SyncOpPointer &&sync_op) {
     auto tag = sync_op->Record(this);
     // As renderpass operations can have side effects on the command buffer access context,
@@ -1237,6 +1314,8 @@ void syncval_state::CommandBufferSubState::Destroy() {
     access_context.Destroy();  // must be first to clean up self references correctly.
 }
 
+void syncval_state::CommandBufferSubState::End() { access_context.End(); }
+
 void syncval_state::CommandBufferSubState::Reset(const Location &loc) { access_context.Reset(); }
 
 void syncval_state::CommandBufferSubState::NotifyInvalidate(const vvl::StateObject::NodeList &invalid_nodes, bool unlink) {
@@ -19,6 +19,7 @@
 #include "sync/sync_renderpass.h"
 #include "sync/sync_reporting.h"
 #include "state_tracker/cmd_buffer_state.h"
+#include "utils/compact_log.h"
 
 struct ReportProperties;
 struct RecordObject;
@@ -114,6 +115,39 @@ struct ResourceUsageRecord {
     AlternateResourceUsage alt_usage;
 };
 
+// Encoding of a ResourceUsageRecord in a CompactAccessLog. The sequence number, handle range and label command index are
+// delta encoded against the previous record. The command buffer state and reset count are kept per run of records.
+// Records with alternate usage are not supported, those only come from queue batch logs.
+struct AccessLogCodec {
+    using Record = ResourceUsageRecord;
+    struct RunKey {
+        const vvl::CommandBuffer *cb_state = nullptr;
+        uint32_t reset_count = 0;
+        bool operator==(const RunKey &other) const { return cb_state == other.cb_state && reset_count == other.reset_count; }
+    };
+    // Indices are stored plus one, so kNoIndex32 becomes zero
+    struct State {
+        uint32_t seq_num = 0;
+        uint32_t handle_end = 0;
+        uint32_t label_command = 0;
+    };
+
+    static RunKey GetRunKey(const Record &record) { return RunKey{record.cb_state, record.reset_count}; }
+    static Record MakeRecord(const RunKey &run) {
+        return Record(vvl::Func::Empty, 0, Record::SubcommandType::kNone, run.cb_state, run.reset_count);
+    }
+    static void EncodeRecord(const Record &record, State &state, std::vector<uint8_t> &bytes);
+    static void DecodeRecord(const uint8_t *&data, State &state, Record &record);
+};
+
+// Read only form of a command buffer access log kept alive by submitted batches. The encoded body does not contain the
+// command buffer state or reset count, so identical recordings can share the same body.
+using CompactAccessLog = vvl::CompactLog<AccessLogCodec>;
+
+// Shares the bodies of identical compact access logs. A body is released as soon as the last submitted batch referencing it
+// is retired.
+using AccessLogCache = CompactAccessLog::BodyDictionary;
+
 // ResourceUsageInfo is similar to ResourceUsageRecord but prioritizes accessibility over memory efficiency.
 // This structure can be as large as needed. Instances are usually stored on the stack.
 struct ResourceUsageInfo {
@@ -202,6 +236,8 @@ class CommandBufferAccessContext : public CommandExecutionContext, DebugNameProv
     }
 
     void Reset();
+    // Recorded contexts are read from submitting threads, make sure nothing is folded into them lazily after this point
+    void End();
 
     ResourceUsageInfo GetResourceUsageInfo(ResourceUsageTagEx tag_ex) const override;
     AccessContext *GetCurrentAccessContext() override { return current_context_; }
@@ -275,6 +311,8 @@ class CommandBufferAccessContext : public CommandExecutionContext, DebugNameProv
         RecordSyncOp(std::move(sync_op));  // Call the non-template version
     }
     std::shared_ptr<AccessLog> GetAccessLogShared() const { return access_log_; }
+    // Compact copy of the access log for submitted batches, built at the end of recording
+    std::shared_ptr<const CompactAccessLog> GetCompactAccessLog() const;
     std::shared_ptr<CommandBufferSet> GetCBReferencesShared() const { return cbs_referenced_; }
     void ImportRecordedAccessLog(const CommandBufferAccessContext &cb_context);
     const std::vector<SyncOpEntry> &GetSyncOps() const { return sync_ops_; };
@@ -288,6 +326,7 @@ class CommandBufferAccessContext : public CommandExecutionContext, DebugNameProv
     CommandBufferAccessContext(const SyncValidator &sync_validator, VkQueueFlags queue_flags);
 
     uint32_t AddHandle(const VulkanTypedHandle &typed_handle, uint32_t index);
+    std::shared_ptr<const CompactAccessLog> MakeCompactAccessLog() const;
 
     // As this is passing around a shared pointer to record, move to avoid needless atomics.
     void RecordSyncOp(SyncOpPointer &&sync_op);
@@ -308,6 +347,8 @@ class CommandBufferAccessContext : public CommandExecutionContext, DebugNameProv
     vvl::CommandBuffer *cb_state_;
 
     std::shared_ptr<AccessLog> access_log_;
+    // Built by End() on the recording thread, submit time validation only reads it
+    std::shared_ptr<const CompactAccessLog> compact_access_log_;
     std::shared_ptr<CommandBufferSet> cbs_referenced_;
     uint32_t command_number_;
     uint32_t reset_count_;
@@ -347,6 +388,7 @@ class CommandBufferSubState : public vvl::CommandBufferSubState {
 
     void NotifyInvalidate(const vvl::StateObject::NodeList &invalid_nodes, bool unlink) override;
 
+    void End() override;
     void Destroy() override;
     void Reset(const Location &loc) override;
 };
@@ -150,3 +150,23 @@ class SingleRangeGenerator {
     const KeyType range_;
     KeyType current_;
 };
+
+// Walks a precomputed list of ranges with the same semantics as other non-trivial range generators.
+// The list must end with an empty range and outlive the generator.
+template <typename KeyType>
+class RangeListGenerator {
+  public:
+    using RangeType = KeyType;
+    explicit RangeListGenerator(const KeyType *ranges) : pos_(ranges) {}
+    const KeyType &operator*() const { return *pos_; }
+    const KeyType *operator->() const { return pos_; }
+    RangeListGenerator &operator++() {
+        if (pos_->non_empty()) {
+            ++pos_;
+        }
+        return *this;
+    }
+
+  private:
+    const KeyType *pos_;
+};
@@ -17,7 +17,8 @@
 #include "sync_image.h"
 #include "state_tracker/state_tracker.h"
 
-syncval_state::ImageSubState::ImageSubState(vvl::Image &image) : vvl::ImageSubState(image), fragment_encoder(image) {}
+syncval_state::ImageSubState::ImageSubState(vvl::Image &image)
+    : vvl::ImageSubState(image), fragment_encoder(image.create_info, image.full_range) {}
 
 bool syncval_state::ImageSubState::IsSimplyBound() const {
     bool simple = SimpleBinding(base) || base.IsSwapchainImage() || base.bind_swapchain;
@@ -85,6 +86,33 @@ ImageRangeGen syncval_state::MakeImageRangeGen(const vvl::ImageView &view) {
     return sub_state.MakeImageRangeGen(view.normalized_subresource_range, view.is_depth_sliced);
 }
 
+syncval_state::ImageViewSubState::ImageViewSubState(vvl::ImageView &view) : vvl::ImageViewSubState(view) {
+    if (!view.image_state || !SubState(*view.image_state).IsSimplyBound()) {
+        return;
+    }
+    // The image is bound before any view is created, so the ranges never change afterwards.
+    // Adjacent ranges are merged, hazard detection and access updates don't depend on how the ranges are split.
+    ImageRangeGen range_gen = MakeImageRangeGen(view);
+    constexpr uint32_t kBatchSize = 16;
+    ResourceAccessRange batch[kBatchSize];
+    for (uint32_t count = range_gen.Fill(batch, kBatchSize); count > 0; count = range_gen.Fill(batch, kBatchSize)) {
+        for (uint32_t i = 0; i < count; ++i) {
+            if (!view_ranges_.empty() && view_ranges_.back().end == batch[i].begin) {
+                view_ranges_.back().end = batch[i].end;
+                continue;
+            }
+            if (view_ranges_.size() == kMaxCachedRanges) {
+                view_ranges_.clear();
+                return;
+            }
+            view_ranges_.emplace_back(batch[i]);
+        }
+    }
+    if (!view_ranges_.empty()) {
+        view_ranges_.emplace_back();
+    }
+}
+
 ImageRangeGen syncval_state::MakeImageRangeGen(const vvl::ImageView &view, const VkOffset3D &offset, const VkExtent3D &extent,
                                                VkImageAspectFlags override_depth_stencil_aspect_mask) {
     if (view.Invalid()) ImageRangeGen();
@@ -19,6 +19,7 @@
 #include "sync/sync_submit.h"
 #include "state_tracker/image_state.h"
 #include "state_tracker/wsi_state.h"
+#include "containers/small_vector.h"
 
 namespace syncval_state {
 
@@ -56,6 +57,37 @@ ImageRangeGen MakeImageRangeGen(const vvl::ImageView &view);
 ImageRangeGen MakeImageRangeGen(const vvl::ImageView &view, const VkOffset3D &offset, const VkExtent3D &extent,
                                 VkImageAspectFlags override_depth_stencil_aspect_mask = 0);
 
+using ImageViewRangeGen = RangeListGenerator<ResourceAccessRange>;
+
+// Caches the address ranges of the whole view, as descriptor accesses use the same views over and over.
+// Views of a full image or of a single subresource usually come down to a single range stored inline.
+class ImageViewSubState : public vvl::ImageViewSubState {
+  public:
+    explicit ImageViewSubState(vvl::ImageView &view);
+
+    // Views that are not simply bound or that produce too many ranges are not cached
+    bool HasCachedRanges() const { return !view_ranges_.empty(); }
+    ImageViewRangeGen MakeCachedRangeGen() const {
+        assert(HasCachedRanges());
+        return ImageViewRangeGen(view_ranges_.data());
+    }
+
+  private:
+    // Beyond this walking the generator is no worse than walking the list
+    static constexpr uint32_t kMaxCachedRanges = 64;
+
+    // Ends with an empty range when not empty
+    small_vector<ResourceAccessRange, 2> view_ranges_;
+};
+
+static inline ImageViewSubState &SubState(vvl::ImageView &view) {
+    return *static_cast<ImageViewSubState *>(view.SubState(LayerObjectTypeSyncValidation));
+}
+
+static inline const ImageViewSubState &SubState(const vvl::ImageView &view) {
+    return *static_cast<const ImageViewSubState *>(view.SubState(LayerObjectTypeSyncValidation));
+}
+
 class SwapchainSubState : public vvl::SwapchainSubState {
   public:
     SwapchainSubState(vvl::Swapchain &swapchain) : vvl::SwapchainSubState(swapchain) {}
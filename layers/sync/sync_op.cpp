@@ -220,6 +220,11 @@ void ApplyBarriers(const std::vector<SyncImageMemoryBarrier> &barriers, QueueId
 
 void ApplyGlobalBarriers(const std::vector<SyncBarrier> &barriers, QueueId queue_id, ResourceUsageTag tag,
                          AccessContext *access_context) {
+    if (queue_id == kQueueIdInvalid) {
+        // Record time, walking the whole map for every barrier is quadratic for barrier heavy command buffers
+        access_context->RecordGlobalBarriers(barriers, tag);
+        return;
+    }
     auto barriers_functor = ApplyBarrierOpsFunctor<PipelineBarrierOp>(true, barriers.size(), tag);
     for (const auto &barrier : barriers) {
         barriers_functor.EmplaceBack(PipelineBarrierOp(queue_id, barrier, false));
@@ -1176,11 +1181,16 @@ bool ReplayState::DetectFirstUseHazard(const ResourceUsageRange &first_use_range
         // We're allowing for the Replay(Validate|Record) to modify the exec_context (e.g. for Renderpass operations), so
         // we need to fetch the current access context each time
         const AccessContext *access_context = GetRecordedAccessContext();
+        const SyncValidator &sync_state = exec_context_.GetSyncState();
 
+        // Submit time replay checks against queue batch contexts, which apply their barriers eagerly and aren't touched by
+        // anything else while the queue submit is validated, so the recorded ranges can be split over the worker threads.
+        // Secondary command buffer replay runs against the recording primary, so it stays on this thread.
+        vvl::ThreadPool *thread_pool =
+            (exec_context_.Handle().type == kVulkanObjectTypeQueue) ? &sync_state.device_state->thread_pool : nullptr;
         const HazardResult hazard = access_context->DetectFirstUseHazard(exec_context_.GetQueueId(), first_use_range,
-                                                                         *exec_context_.GetCurrentAccessContext());
+                                                                         *exec_context_.GetCurrentAccessContext(), thread_pool);
         if (hazard.IsHazard()) {
-            const SyncValidator &sync_state = exec_context_.GetSyncState();
             LogObjectList objlist(exec_context_.Handle(), recorded_context_.Handle());
             const std::string error = sync_state.error_messages_.FirstUseError(hazard, exec_context_, recorded_context_, index_);
             skip |= sync_state.SyncError(hazard.Hazard(), objlist, error_obj_.location, error);
@@ -17,8 +17,23 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+
 struct SyncValSettings {
     bool submit_time_validation = true;
     bool shader_accesses_heuristic = false;
     bool message_extra_properties = false;
+
+    // Bounded history mode. When a queue keeps more than max_retained_submits submits of tracked accesses,
+    // or the tracked accesses take more than max_retained_history_mb megabytes, the oldest submits on that queue
+    // are treated as completed. Zero means no limit.
+    uint32_t max_retained_submits = 0;
+    uint32_t max_retained_history_mb = 0;
+
+    // Runtime memory and cost telemetry. A report is written every telemetry_report_interval submits (zero disables
+    // periodic reports) and when the device is destroyed, to telemetry_filename or stdout when no file is given.
+    bool telemetry = false;
+    uint32_t telemetry_report_interval = 1000;
+    std::string telemetry_filename;
 };
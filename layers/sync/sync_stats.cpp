@@ -71,6 +71,8 @@ void Stats::RemoveUnresolvedBatch() { unresolved_batch_counter.Sub(1); }
 void Stats::AddHandleRecord(uint32_t count) { handle_record_counter.Add(count); }
 void Stats::RemoveHandleRecord(uint32_t count) { handle_record_counter.Sub(count); }
 
+void Stats::AddHistoryTruncation() { history_truncation_counter.Add(1); }
+
 void Stats::ReportOnDestruction() { report_on_destruction = true; }
 
 std::string Stats::CreateReport() {
@@ -114,6 +116,16 @@ std::string Stats::CreateReport() {
         str << "\tmax_count = " << handle_record_max << '\n';
         str << "\tmax_memory = " << handle_record_max_memory << " bytes\n";
     }
+    {
+        // Range key plus access state, not counting the container's own per node overhead
+        str << "ResourceAccessState:\n";
+        str << "\tmemory per tracked range = " << sizeof(ResourceAccessRangeMap::value_type) << " bytes\n";
+    }
+    {
+        uint32_t history_truncation = history_truncation_counter.u32;
+        str << "History truncation:\n";
+        str << "\tcount = " << history_truncation << "\n";
+    }
     return str.str();
 }
 
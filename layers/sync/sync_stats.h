@@ -70,6 +70,10 @@ struct Stats {
     void AddHandleRecord(uint32_t count = 1);
     void RemoveHandleRecord(uint32_t count = 1);
 
+    // Number of times the bounded history mode dropped the oldest submits of a queue
+    Value32 history_truncation_counter;
+    void AddHistoryTruncation();
+
     void ReportOnDestruction();
     std::string CreateReport();
 };
@@ -86,6 +90,7 @@ struct Stats {
     void RemoveTimelineSignals(uint32_t count) {}
     void AddUnresolvedBatch() {}
     void RemoveUnresolvedBatch() {}
+    void AddHistoryTruncation() {}
     void ReportOnDestruction() {}
     std::string CreateReport() { return "SyncVal stats are disabled in the current build configuration\n"; }
 };
@@ -754,6 +754,14 @@ void BatchAccessLog::Insert(const BatchRecord& batch, const ResourceUsageRange&
     log_map_.insert(std::make_pair(range, CBSubmitLog(batch, nullptr, std::move(log))));
 }
 
+size_t BatchAccessLog::RecordCount() const {
+    size_t record_count = 0;
+    for (const auto& [_, cb_log] : log_map_) {
+        record_count += cb_log.Size();
+    }
+    return record_count;
+}
+
 // Trim: Remove any unreferenced AccessLog ranges from a BatchAccessLog
 //
 // In order to contain memory growth in the AccessLog information regarding prior submitted command buffers,
@@ -827,11 +835,16 @@ std::string BatchAccessLog::CBSubmitLog::GetDebugRegionName(const ResourceUsageR
 BatchAccessLog::AccessRecord BatchAccessLog::CBSubmitLog::GetAccessRecord(ResourceUsageTag tag) const {
     assert(tag >= batch_.base_tag);
     const size_t index = tag - batch_.base_tag;
-    assert(log_);
-    assert(index < log_->size());
-    const ResourceUsageRecord* record = &(*log_)[index];
+    assert(index < Size());
+    std::optional<ResourceUsageRecord> record;
+    if (compact_log_) {
+        record.emplace(compact_log_->Decode(static_cast<uint32_t>(index)));
+    } else {
+        assert(log_);
+        record.emplace((*log_)[index]);
+    }
     const auto debug_name_provider = (record->label_command_index == vvl::kU32Max) ? nullptr : this;
-    return AccessRecord{&batch_, record, debug_name_provider};
+    return AccessRecord{&batch_, std::move(record), debug_name_provider};
 }
 
 BatchAccessLog::CBSubmitLog::CBSubmitLog(const BatchRecord& batch,
@@ -841,7 +854,10 @@ BatchAccessLog::CBSubmitLog::CBSubmitLog(const BatchRecord& batch,
 
 BatchAccessLog::CBSubmitLog::CBSubmitLog(const BatchRecord& batch, const CommandBufferAccessContext& cb,
                                          const std::vector<std::string>& initial_label_stack)
-    : batch_(batch), cbs_(cb.GetCBReferencesShared()), log_(cb.GetAccessLogShared()), initial_label_stack_(initial_label_stack) {}
+    : batch_(batch),
+      cbs_(cb.GetCBReferencesShared()),
+      compact_log_(cb.GetCompactAccessLog()),
+      initial_label_stack_(initial_label_stack) {}
 
 PresentedImage::PresentedImage(SyncValidator& sync_state, QueueBatchContext::Ptr batch_, VkSwapchainKHR swapchain,
                                uint32_t image_index_, uint32_t present_index_, ResourceUsageTag tag_)
@@ -16,6 +16,8 @@
  */
 
 #pragma once
+#include <deque>
+#include <optional>
 #include "sync/sync_commandbuffer.h"
 #include "state_tracker/queue_state.h"
 
@@ -179,9 +181,10 @@ class BatchAccessLog {
     };
 
     struct AccessRecord {
-        const BatchRecord *batch;
-        const ResourceUsageRecord *record;
-        const DebugNameProvider *debug_name_provider;
+        const BatchRecord *batch = nullptr;
+        // Decoded copy, command buffer logs are stored in compact form
+        std::optional<ResourceUsageRecord> record;
+        const DebugNameProvider *debug_name_provider = nullptr;
         bool IsValid() const { return batch && record; }
     };
 
@@ -196,7 +199,7 @@ class BatchAccessLog {
                     std::shared_ptr<const CommandExecutionContext::AccessLog> log);
         CBSubmitLog(const BatchRecord &batch, const CommandBufferAccessContext &cb,
                     const std::vector<std::string> &initial_label_stack);
-        size_t Size() const { return log_->size(); }
+        size_t Size() const { return compact_log_ ? compact_log_->Size() : log_->size(); }
         AccessRecord GetAccessRecord(ResourceUsageTag tag) const;
 
         // DebugNameProvider
@@ -205,7 +208,9 @@ class BatchAccessLog {
       private:
         BatchRecord batch_;
         std::shared_ptr<const CommandExecutionContext::CommandBufferSet> cbs_;
+        // Command buffer logs use compact_log_, log_ holds the few records created by queue operations
         std::shared_ptr<const CommandExecutionContext::AccessLog> log_;
+        std::shared_ptr<const CompactAccessLog> compact_log_;
         // label stack at the point when command buffer is submitted to the queue
         std::vector<std::string> initial_label_stack_;
     };
@@ -219,6 +224,8 @@ class BatchAccessLog {
     void Trim(const ResourceUsageTagSet &used);
     // AccessRecord lookup is based on global tags
     AccessRecord GetAccessRecord(ResourceUsageTag tag) const;
+    // Total number of access records referenced by the imported command buffer logs
+    size_t RecordCount() const;
     BatchAccessLog() {}
 
   private:
@@ -303,6 +310,10 @@ class QueueBatchContext : public CommandExecutionContext, public std::enable_sha
     const QueueSyncState *GetQueueSyncState() { return queue_state_; }
     QueueId GetQueueId() const override;
     ResourceUsageRange GetTagRange() const { return tag_range_; }
+    // Number of tracked ranges, used to estimate the history size in bounded history mode
+    size_t GetAccessStateCount() const { return access_context_.GetAccessStateMap().size(); }
+    const ResourceAccessRangeMap &GetAccessStateMap() const { return access_context_.GetAccessStateMap(); }
+    size_t GetBatchLogRecordCount() const { return batch_log_.RecordCount(); }
 
     ResourceUsageTag SetupBatchTags(uint32_t tag_count);
     void ResetEventsContext() { events_context_.Clear(); }
@@ -395,6 +406,9 @@ class QueueSyncState {
     // the only exception is when validation error happens.
     void ClearPending() const;
 
+    // Bounded history mode: last tag of each submit on this queue whose accesses might still be tracked, oldest first.
+    std::deque<ResourceUsageTag> &RetainedSubmitTags() { return retained_submit_tags_; }
+
   private:
     const QueueId id_;
     std::shared_ptr<vvl::Queue> queue_state_;
@@ -412,6 +426,8 @@ class QueueSyncState {
     mutable QueueBatchContext::Ptr pending_last_batch_;
     mutable std::vector<UnresolvedBatch> pending_unresolved_batches_;
     mutable bool update_unresolved_batches_ = false;
+
+    std::deque<ResourceUsageTag> retained_submit_tags_;
 };
 
 struct QueueSubmitCmdState {
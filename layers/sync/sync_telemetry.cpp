@@ -0,0 +1,181 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sync/sync_telemetry.h"
+#include "sync/sync_access_state.h"
+#include "sync/sync_settings.h"
+#include "utils/vk_layer_utils.h"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+namespace syncval_telemetry {
+
+static const char *PhaseName(Phase phase) {
+    switch (phase) {
+        case Phase::SubmitValidate:
+            return "submit validation";
+        case Phase::SubmitRecord:
+            return "submit record";
+        case Phase::PresentValidate:
+            return "present validation";
+        case Phase::PresentRecord:
+            return "present record";
+        default:
+            return "unknown";
+    }
+}
+
+Telemetry::ScopedTimer::ScopedTimer(Telemetry &telemetry, Phase phase)
+    : telemetry_(telemetry.enabled_ ? &telemetry : nullptr), phase_(phase) {
+    if (telemetry_) {
+        start_ = std::chrono::steady_clock::now();
+    }
+}
+
+Telemetry::ScopedTimer::~ScopedTimer() {
+    if (!telemetry_) {
+        return;
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+    const uint32_t index = static_cast<uint32_t>(phase_);
+    telemetry_->phase_calls_[index].fetch_add(1, std::memory_order_relaxed);
+    telemetry_->phase_time_ns_[index].fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+    telemetry_->CollectWorkCounters();
+}
+
+void AccessStateMapSizes::Add(const ResourceAccessRangeMap &map) {
+    // Red-black tree links and color of a std::map node
+    constexpr uint64_t node_overhead = 4 * sizeof(void *);
+    uint64_t map_bytes = map.size() * (sizeof(ResourceAccessRangeMap::value_type) + node_overhead);
+    for (const auto &entry : map) {
+        map_bytes += entry.second.HeapSize();
+    }
+    ++map_count;
+    entry_count += map.size();
+    max_entry_count = std::max<uint64_t>(max_entry_count, map.size());
+    bytes += map_bytes;
+    max_bytes = std::max(max_bytes, map_bytes);
+}
+
+void Telemetry::Init(const SyncValSettings &settings) {
+    enabled_ = settings.telemetry;
+    report_interval_ = settings.telemetry_report_interval;
+    if (enabled_) {
+        counting_work.store(true, std::memory_order_relaxed);
+    }
+    if (enabled_ && !settings.telemetry_filename.empty()) {
+        output_file_.open(settings.telemetry_filename, std::ios::out | std::ios::app);
+    }
+}
+
+void Telemetry::CollectWorkCounters() {
+    WorkCounters &counters = work_counters;
+    hazard_checks_.fetch_add(counters.hazard_checks, std::memory_order_relaxed);
+    hazard_ranges_.fetch_add(counters.hazard_ranges, std::memory_order_relaxed);
+    barriers_.fetch_add(counters.barriers, std::memory_order_relaxed);
+    barrier_ranges_.fetch_add(counters.barrier_ranges, std::memory_order_relaxed);
+    counters = WorkCounters{};
+}
+
+void Telemetry::AddCommandBuffer(const AccessStateMapSizes &access_state_maps, uint64_t access_log_size) {
+    if (!enabled_) {
+        return;
+    }
+    command_buffer_count_.fetch_add(1, std::memory_order_relaxed);
+    command_buffer_access_states_.fetch_add(access_state_maps.entry_count, std::memory_order_relaxed);
+    command_buffer_access_state_bytes_.fetch_add(access_state_maps.bytes, std::memory_order_relaxed);
+    command_buffer_access_log_.fetch_add(access_log_size, std::memory_order_relaxed);
+    vvl::atomic_fetch_max(command_buffer_max_access_states_, access_state_maps.entry_count);
+    vvl::atomic_fetch_max(command_buffer_max_access_state_bytes_, access_state_maps.bytes);
+    vvl::atomic_fetch_max(max_access_state_map_bytes_, access_state_maps.max_bytes);
+    vvl::atomic_fetch_max(command_buffer_max_access_log_, access_log_size);
+    CollectWorkCounters();
+}
+
+bool Telemetry::CountSubmit() {
+    if (!enabled_) {
+        return false;
+    }
+    const uint64_t submit_count = submit_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+    return report_interval_ != 0 && (submit_count % report_interval_) == 0;
+}
+
+void Telemetry::WriteReport(const HistorySnapshot &history, const char *reason) {
+    if (!enabled_) {
+        return;
+    }
+    CollectWorkCounters();
+    const std::string report = CreateReport(history, reason);
+
+    std::lock_guard<std::mutex> guard(output_lock_);
+    if (output_file_.is_open()) {
+        output_file_ << report;
+        output_file_.flush();
+    } else {
+        std::cout << report;
+    }
+}
+
+std::string Telemetry::CreateReport(const HistorySnapshot &history, const char *reason) const {
+    auto average = [](uint64_t total, uint64_t count) { return count ? double(total) / double(count) : 0.0; };
+
+    std::ostringstream str;
+    str << "SyncVal telemetry (" << reason << ", submit " << submit_count_.load() << "):\n";
+    for (uint32_t i = 0; i < kPhaseCount; ++i) {
+        const uint64_t calls = phase_calls_[i].load();
+        const double time_ms = double(phase_time_ns_[i].load()) / 1.0e6;
+        str << "\t" << PhaseName(Phase(i)) << ": calls = " << calls << ", time = " << time_ms
+            << " ms, average = " << average(phase_time_ns_[i].load(), calls) / 1.0e3 << " us\n";
+    }
+    {
+        const uint64_t checks = hazard_checks_.load();
+        const uint64_t ranges = hazard_ranges_.load();
+        str << "\thazard checks: count = " << checks << ", ranges visited = " << ranges
+            << ", ranges per check = " << average(ranges, checks) << "\n";
+    }
+    {
+        const uint64_t barriers = barriers_.load();
+        const uint64_t ranges = barrier_ranges_.load();
+        str << "\tbarriers: count = " << barriers << ", ranges visited = " << ranges
+            << ", ranges per barrier = " << average(ranges, barriers) << "\n";
+    }
+    {
+        const uint64_t count = command_buffer_count_.load();
+        const uint64_t access_state_bytes = command_buffer_access_state_bytes_.load();
+        str << "\tcommand buffers: recorded = " << count << "\n";
+        str << "\t\taccess states: average = " << average(command_buffer_access_states_.load(), count)
+            << ", max = " << command_buffer_max_access_states_.load() << "\n";
+        str << "\t\taccess state memory: average = " << average(access_state_bytes, count)
+            << " bytes, max = " << command_buffer_max_access_state_bytes_.load()
+            << " bytes, largest map = " << max_access_state_map_bytes_.load() << " bytes\n";
+        str << "\t\taccess log: average = " << average(command_buffer_access_log_.load(), count)
+            << ", max = " << command_buffer_max_access_log_.load() << "\n";
+    }
+    {
+        const AccessStateMapSizes &maps = history.access_state_maps;
+        str << "\tqueue batches: count = " << maps.map_count << "\n";
+        str << "\t\taccess states: total = " << maps.entry_count << ", max = " << maps.max_entry_count << "\n";
+        str << "\t\taccess state memory: total = " << maps.bytes << " bytes, largest map = " << maps.max_bytes
+            << " bytes\n";
+        str << "\t\tbatch access log records = " << history.batch_log_record_count << "\n";
+    }
+    return str.str();
+}
+
+}  // namespace syncval_telemetry
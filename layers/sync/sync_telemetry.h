@@ -0,0 +1,131 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#include "sync/sync_access_state.h"
+
+struct SyncValSettings;
+
+namespace syncval_telemetry {
+
+// Work counters bumped from the access context hot paths, only after checking CountingWork(). Timed scopes and the
+// end of command buffer recording move them into the device totals.
+struct WorkCounters {
+    uint64_t hazard_checks = 0;
+    uint64_t hazard_ranges = 0;  // map entries visited by hazard checks
+    uint64_t barriers = 0;
+    uint64_t barrier_ranges = 0;  // map entries visited by barrier application
+};
+inline thread_local WorkCounters work_counters;
+
+// Set by Init once any device enables telemetry. Without it the hot paths pay for a relaxed load of a cached bool.
+inline std::atomic<bool> counting_work{false};
+inline bool CountingWork() { return counting_work.load(std::memory_order_relaxed); }
+
+// Validate and record of a submit or present are timed separately, each of them once per call
+enum class Phase { SubmitValidate = 0, SubmitRecord, PresentValidate, PresentRecord, Count };
+
+// Entry counts and byte sizes of a group of ResourceAccessRangeMaps. The byte size of a map covers its entries, the
+// heap memory owned by their access states and an estimate of the container's per node overhead.
+struct AccessStateMapSizes {
+    uint64_t map_count = 0;
+    uint64_t entry_count = 0;
+    uint64_t max_entry_count = 0;
+    uint64_t bytes = 0;
+    uint64_t max_bytes = 0;
+
+    void Add(const ResourceAccessRangeMap &map);
+};
+
+// Queue batch history gathered at report time
+struct HistorySnapshot {
+    AccessStateMapSizes access_state_maps;  // one map per batch
+    uint64_t batch_log_record_count = 0;
+};
+
+// Memory and cost telemetry enabled at runtime by the syncval_telemetry setting. Unlike syncval_stats it is always
+// compiled in, when disabled every entry point returns after checking a bool.
+class Telemetry {
+  public:
+    class ScopedTimer {
+      public:
+        ScopedTimer(Telemetry &telemetry, Phase phase);
+        ~ScopedTimer();
+        ScopedTimer(const ScopedTimer &) = delete;
+        ScopedTimer &operator=(const ScopedTimer &) = delete;
+
+      private:
+        Telemetry *telemetry_;
+        Phase phase_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    void Init(const SyncValSettings &settings);
+    bool Enabled() const { return enabled_; }
+
+    // Times the enclosing scope. Also collects the work counters of the calling thread.
+    [[nodiscard]] ScopedTimer Time(Phase phase) { return ScopedTimer(*this, phase); }
+
+    // Sizes of a command buffer access context at the end of recording. Also collects the work counters of the calling
+    // thread, which hold the hazard checks and barriers of the recorded commands.
+    void AddCommandBuffer(const AccessStateMapSizes &access_state_maps, uint64_t access_log_size);
+
+    // Counts a submit or present. Returns true when the periodic report is due.
+    bool CountSubmit();
+
+    void WriteReport(const HistorySnapshot &history, const char *reason);
+
+  private:
+    static constexpr uint32_t kPhaseCount = static_cast<uint32_t>(Phase::Count);
+
+    void CollectWorkCounters();
+    std::string CreateReport(const HistorySnapshot &history, const char *reason) const;
+
+    bool enabled_ = false;
+    uint32_t report_interval_ = 0;
+    std::atomic<uint64_t> submit_count_{0};
+
+    std::atomic<uint64_t> phase_calls_[kPhaseCount] = {};
+    std::atomic<uint64_t> phase_time_ns_[kPhaseCount] = {};
+
+    std::atomic<uint64_t> hazard_checks_{0};
+    std::atomic<uint64_t> hazard_ranges_{0};
+    std::atomic<uint64_t> barriers_{0};
+    std::atomic<uint64_t> barrier_ranges_{0};
+
+    std::atomic<uint64_t> command_buffer_count_{0};
+    std::atomic<uint64_t> command_buffer_access_states_{0};
+    std::atomic<uint64_t> command_buffer_max_access_states_{0};
+    std::atomic<uint64_t> command_buffer_access_state_bytes_{0};
+    std::atomic<uint64_t> command_buffer_max_access_state_bytes_{0};
+    std::atomic<uint64_t> max_access_state_map_bytes_{0};  // largest single map of any command buffer
+    std::atomic<uint64_t> command_buffer_access_log_{0};
+    std::atomic<uint64_t> command_buffer_max_access_log_{0};
+
+    std::mutex output_lock_;
+    std::ofstream output_file_;
+};
+
+}  // namespace syncval_telemetry
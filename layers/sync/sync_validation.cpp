@@ -25,6 +25,7 @@
 #include "state_tracker/buffer_state.h"
 #include "state_tracker/ray_tracing_state.h"
 #include "utils/convert_utils.h"
+#include "utils/hash_util.h"
 #include "utils/ray_tracing_utils.h"
 #include "utils/text_utils.h"
 #include "vk_layer_config.h"
@@ -47,7 +48,9 @@ void SyncValidator::DebugCapture() {}
 
 bool SyncValidator::SyncError(SyncHazard hazard, const LogObjectList &objlist, const Location &loc,
                               const std::string &error_message) const {
-    return LogError(string_SyncHazardVUID(hazard), objlist, loc, "%s", error_message.c_str());
+    const bool skip = LogError(string_SyncHazardVUID(hazard), objlist, loc, "%s", error_message.c_str());
+    hazard_suppression.CountReport(hazard, debug_report->duplicate_message_limit);
+    return skip;
 }
 
 ResourceUsageRange SyncValidator::ReserveGlobalTagRange(size_t tag_count) const {
@@ -169,6 +172,76 @@ void SyncValidator::ApplyTaggedWait(QueueId queue_id, ResourceUsageTag tag) {
         }
     };
     ForAllQueueBatchContexts(tagged_wait_op);
+    ReleaseRetainedSubmits(queue_id, tag);
+}
+
+void SyncValidator::ReleaseRetainedSubmits(QueueId queue_id, ResourceUsageTag tag) {
+    for (const auto &queue_state : queue_sync_states_) {
+        if (queue_id != kQueueAny && queue_state->GetQueueId() != queue_id) {
+            continue;
+        }
+        std::deque<ResourceUsageTag> &retained_tags = queue_state->RetainedSubmitTags();
+        while (!retained_tags.empty() && retained_tags.front() <= tag) {
+            retained_tags.pop_front();
+        }
+    }
+}
+
+void SyncValidator::ApplyHistoryLimits(QueueSyncState &queue_state) {
+    const uint32_t max_submits = syncval_settings.max_retained_submits;
+    const uint64_t max_memory = uint64_t(syncval_settings.max_retained_history_mb) * 1024 * 1024;
+    if (max_submits == 0 && max_memory == 0) {
+        return;
+    }
+    const QueueBatchContext::Ptr last_batch = queue_state.LastBatch();
+    if (!last_batch) {
+        return;
+    }
+    std::deque<ResourceUsageTag> &retained_tags = queue_state.RetainedSubmitTags();
+    const ResourceUsageRange tag_range = last_batch->GetTagRange();
+    if (tag_range.non_empty() && (retained_tags.empty() || retained_tags.back() < tag_range.end - 1)) {
+        retained_tags.emplace_back(tag_range.end - 1);
+    }
+    // Without a submit limit the tags are only released by waits. Forgetting the oldest tag without a wait is safe,
+    // the next truncation waits for a later tag on this queue and that also completes the forgotten submits.
+    const size_t kMaxRetainedSubmitTags = 1024;
+    if (max_submits == 0 && retained_tags.size() > kMaxRetainedSubmitTags) {
+        retained_tags.pop_front();
+    }
+
+    // The most recent submit is always kept, so the next submit on this queue still validates against it
+    bool truncated = false;
+    while (retained_tags.size() > 1) {
+        const bool over_submit_limit = max_submits != 0 && retained_tags.size() > max_submits;
+        if (!over_submit_limit && (max_memory == 0 || EstimateHistoryMemory() <= max_memory)) {
+            break;
+        }
+        // Act as if the host waited for the oldest retained submit. Its accesses (and older ones on this queue) become
+        // completed, which can hide hazards against them but never reports new ones.
+        // Also releases the tag of the waited submit
+        ApplyTaggedWait(queue_state.GetQueueId(), retained_tags.front());
+        truncated = true;
+    }
+    if (truncated) {
+        stats.AddHistoryTruncation();
+    }
+}
+
+// Counts only the range map entries, heap memory owned by the access states (e.g. additional reads) is not included
+uint64_t SyncValidator::EstimateHistoryMemory() {
+    uint64_t access_state_count = 0;
+    ForAllQueueBatchContexts(
+        [&access_state_count](const QueueBatchContext::Ptr &batch) { access_state_count += batch->GetAccessStateCount(); });
+    return access_state_count * sizeof(ResourceAccessRangeMap::value_type);
+}
+
+void SyncValidator::ReportTelemetry(const char *reason) {
+    syncval_telemetry::HistorySnapshot history;
+    ForAllQueueBatchContexts([&history](const QueueBatchContext::Ptr &batch) {
+        history.access_state_maps.Add(batch->GetAccessStateMap());
+        history.batch_log_record_count += batch->GetBatchLogRecordCount();
+    });
+    telemetry.WriteReport(history, reason);
 }
 
 void SyncValidator::ApplyAcquireWait(const AcquiredImage &acquired) {
@@ -301,6 +374,10 @@ void SyncValidator::Created(vvl::Image &image_state) {
     image_state.SetSubState(container_type, std::make_unique<syncval_state::ImageSubState>(image_state));
 }
 
+void SyncValidator::Created(vvl::ImageView &image_view_state) {
+    image_view_state.SetSubState(container_type, std::make_unique<syncval_state::ImageViewSubState>(image_view_state));
+}
+
 void SyncValidator::PreCallRecordDestroyBuffer(VkDevice device, VkBuffer buffer, const VkAllocationCallbacks *pAllocator,
                                                const RecordObject &record_obj) {
     if (const auto buffer_state = Get<vvl::Buffer>(buffer)) {
@@ -755,10 +832,22 @@ void SyncValidator::FinishDeviceSetup(const VkDeviceCreateInfo *pCreateInfo, con
     }
     debug_cmdbuf_pattern = GetEnvironment("VK_SYNCVAL_DEBUG_CMDBUF_PATTERN");
     text::ToLower(debug_cmdbuf_pattern);
+
+    for (uint32_t hazard = SyncHazard::READ_AFTER_WRITE; hazard <= SyncHazard::PRESENT_AFTER_WRITE; ++hazard) {
+        const uint32_t vuid_hash = hash_util::VuidHash(string_SyncHazardVUID(SyncHazard(hazard)));
+        if (debug_report->filter_message_ids.find(vuid_hash) != debug_report->filter_message_ids.end()) {
+            hazard_suppression.Suppress(SyncHazard(hazard));
+        }
+    }
+
+    telemetry.Init(syncval_settings);
 }
 
 void SyncValidator::PreCallRecordDestroyDevice(VkDevice device, const VkAllocationCallbacks *pAllocator,
                                                const RecordObject &record_obj) {
+    if (telemetry.Enabled()) {
+        ReportTelemetry("device destroyed");
+    }
     queue_sync_states_.clear();
     binary_signals_.clear();
     timeline_signals_.clear();
@@ -3050,6 +3139,7 @@ void SyncValidator::PostCallRecordDeviceWaitIdle(VkDevice device, const RecordOb
     // We need to treat this a fence waits for all queues... noting that present engine ops will be preserved.
     ForAllQueueBatchContexts(
         [](const QueueBatchContext::Ptr &batch) { batch->ApplyTaggedWait(kQueueAny, ResourceUsageRecord::kMaxIndex); });
+    ReleaseRetainedSubmits(kQueueAny, ResourceUsageRecord::kMaxIndex);
 
     // For each timeline keep only the last signal per queue.
     // The last signal is needed to represent the current timeline state.
@@ -3074,6 +3164,7 @@ bool SyncValidator::PreCallValidateQueuePresentKHR(VkQueue queue, const VkPresen
     // Since this early return is above the TlsGuard, the Record phase must also be.
     if (!syncval_settings.submit_time_validation) return skip;
 
+    const auto telemetry_timer = telemetry.Time(syncval_telemetry::Phase::PresentValidate);
     ClearPending();
 
     vvl::TlsGuard<QueuePresentCmdState> cmd_state(&skip, *this);
@@ -3156,11 +3247,18 @@ void SyncValidator::PostCallRecordQueuePresentKHR(VkQueue queue, const VkPresent
     // Update the state with the data from the validate phase
     std::shared_ptr<QueueSyncState> queue_state = std::const_pointer_cast<QueueSyncState>(std::move(cmd_state->queue));
     if (!queue_state) return;  // Invalid Queue
-    ApplySignalsUpdate(cmd_state->signals_update, queue_state->PendingLastBatch());
-    for (auto &presented : cmd_state->presented_images) {
-        presented.ExportToSwapchain(*this);
+    {
+        const auto telemetry_timer = telemetry.Time(syncval_telemetry::Phase::PresentRecord);
+        ApplySignalsUpdate(cmd_state->signals_update, queue_state->PendingLastBatch());
+        for (auto &presented : cmd_state->presented_images) {
+            presented.ExportToSwapchain(*this);
+        }
+        queue_state->ApplyPendingLastBatch();
+        ApplyHistoryLimits(*queue_state);
+    }
+    if (telemetry.CountSubmit()) {
+        ReportTelemetry("periodic");
     }
-    queue_state->ApplyPendingLastBatch();
 }
 
 void SyncValidator::PostCallRecordAcquireNextImageKHR(VkDevice device, VkSwapchainKHR swapchain, uint64_t timeout,
@@ -3249,6 +3347,7 @@ bool SyncValidator::ValidateQueueSubmit(VkQueue queue, uint32_t submitCount, con
     // Since this early return is above the TlsGuard, the Record phase must also be.
     if (!syncval_settings.submit_time_validation) return skip;
 
+    const auto telemetry_timer = telemetry.Time(syncval_telemetry::Phase::SubmitValidate);
     std::lock_guard lock_guard(queue_submit_mutex_);
 
     ClearPending();
@@ -3457,21 +3556,29 @@ void SyncValidator::RecordQueueSubmit(VkQueue queue, VkFence fence, QueueSubmitC
 
     if (!cmd_state->queue) return;  // Validation couldn't find a valid queue object
 
-    // Don't need to look up the queue state again, but we need a non-const version
-    std::shared_ptr<QueueSyncState> queue_state = std::const_pointer_cast<QueueSyncState>(std::move(cmd_state->queue));
-    ApplySignalsUpdate(cmd_state->signals_update, queue_state->PendingLastBatch());
+    {
+        const auto telemetry_timer = telemetry.Time(syncval_telemetry::Phase::SubmitRecord);
 
-    // Apply the pending state from the validation phase. Check all queues because timeline signals
-    // on the current queue can resolve wait-before-signal batches on other queues.
-    for (const auto &qs : queue_sync_states_) {
-        qs->ApplyPendingLastBatch();
-        qs->ApplyPendingUnresolvedBatches();
-    }
+        // Don't need to look up the queue state again, but we need a non-const version
+        std::shared_ptr<QueueSyncState> queue_state = std::const_pointer_cast<QueueSyncState>(std::move(cmd_state->queue));
+        ApplySignalsUpdate(cmd_state->signals_update, queue_state->PendingLastBatch());
 
-    FenceHostSyncPoint sync_point;
-    sync_point.queue_id = queue_state->GetQueueId();
-    sync_point.tag = ReserveGlobalTagRange(1).begin;
-    UpdateFenceHostSyncPoint(fence, std::move(sync_point));
+        // Apply the pending state from the validation phase. Check all queues because timeline signals
+        // on the current queue can resolve wait-before-signal batches on other queues.
+        for (const auto &qs : queue_sync_states_) {
+            qs->ApplyPendingLastBatch();
+            qs->ApplyPendingUnresolvedBatches();
+        }
+        ApplyHistoryLimits(*queue_state);
+
+        FenceHostSyncPoint sync_point;
+        sync_point.queue_id = queue_state->GetQueueId();
+        sync_point.tag = ReserveGlobalTagRange(1).begin;
+        UpdateFenceHostSyncPoint(fence, std::move(sync_point));
+    }
+    if (telemetry.CountSubmit()) {
+        ReportTelemetry("periodic");
+    }
 }
 
 bool SyncValidator::PreCallValidateQueueSubmit2KHR(VkQueue queue, uint32_t submitCount, const VkSubmitInfo2KHR *pSubmits,
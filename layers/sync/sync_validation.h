@@ -26,6 +26,7 @@
 #include "sync/sync_commandbuffer.h"
 #include "sync/sync_error_messages.h"
 #include "sync/sync_stats.h"
+#include "sync/sync_telemetry.h"
 #include "sync/sync_submit.h"
 #include "containers/limits.h"
 
@@ -55,6 +56,7 @@ class SyncValidator : public vvl::DeviceProxy, public SyncStageAccess {
     // - it is the first to be constructed: can observe all subsequent syncval stats events
     // - it is the last to be destroyed: ensures there are no unreported syncval stats events.
     mutable syncval_stats::Stats stats;  // Stats object is thread safe
+    mutable syncval_telemetry::Telemetry telemetry;  // Telemetry object is thread safe
 
     // Global tag range for submitted command buffers resource usage logs
     // Started the global tag count at 1 s.t. zero are invalid and ResourceUsageTag normalization can just zero them.
@@ -65,6 +67,10 @@ class SyncValidator : public vvl::DeviceProxy, public SyncStageAccess {
     QueueId queue_id_limit_ = 0;
 
     mutable std::mutex queue_submit_mutex_;
+    // Shares the compact access logs of identically recorded command buffers between submissions
+    mutable AccessLogCache access_log_cache;
+    // Hazard types that can no longer be reported, counted as SyncError reports them
+    mutable HazardSuppression hazard_suppression;
 
     // Semaphore signal registry
     vvl::unordered_map<VkSemaphore, SignalInfo> binary_signals_;
@@ -104,6 +110,13 @@ class SyncValidator : public vvl::DeviceProxy, public SyncStageAccess {
                                 bool &skip, const ErrorObject &error_obj) const;
 
     void ApplyTaggedWait(QueueId queue_id, ResourceUsageTag tag);
+    // Drops the bounded history tags of the submits completed by a wait
+    void ReleaseRetainedSubmits(QueueId queue_id, ResourceUsageTag tag);
+    // Bounded history mode. Treats the oldest submits on the queue as completed once the queue retains more submits,
+    // or all batches track more memory, than the syncval settings allow.
+    void ApplyHistoryLimits(QueueSyncState &queue_state);
+    uint64_t EstimateHistoryMemory();
+    void ReportTelemetry(const char *reason);
     void ApplyAcquireWait(const AcquiredImage &acquired);
 
      // Go through every queue batch context and apply synchronization operation
@@ -128,6 +141,7 @@ class SyncValidator : public vvl::DeviceProxy, public SyncStageAccess {
     void Created(vvl::CommandBuffer &cb_state) override;
     void Created(vvl::Swapchain &swapchain_state) override;
     void Created(vvl::Image &image_state) override;
+    void Created(vvl::ImageView &image_view_state) override;
 
     void DebugCapture() final;
 
@@ -0,0 +1,150 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "utils/hash_util.h"
+
+namespace vvl {
+
+// LEB128 style variable length integers, 7 bits per byte
+inline void EncodeVarint(uint64_t value, std::vector<uint8_t> &bytes) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+inline uint64_t DecodeVarint(const uint8_t *&data) {
+    uint64_t value = 0;
+    for (uint32_t shift = 0;; shift += 7) {
+        const uint8_t byte = *data++;
+        value |= uint64_t(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+}
+
+// Signed difference mapped to an unsigned value so that small negative deltas also encode into a single byte
+inline uint32_t EncodeDelta(uint32_t value, uint32_t previous) {
+    const uint32_t delta = value - previous;
+    return (delta << 1) ^ (0u - (delta >> 31));
+}
+
+inline uint32_t DecodeDelta(uint32_t encoded, uint32_t previous) { return previous + ((encoded >> 1) ^ (0u - (encoded & 1))); }
+
+// Read only log of records stored as varint encoded bytes, decoded one record at a time on lookup.
+//
+// Codec provides:
+//  - Record, the decoded type, and RunKey, the per record data that isn't part of the encoded bytes
+//  - State, the values a record is delta encoded against. It is reset every kBlockSize records, so a lookup decodes at most
+//    one block.
+//  - static RunKey GetRunKey(const Record &) and static Record MakeRecord(const RunKey &)
+//  - static void EncodeRecord(const Record &, State &, std::vector<uint8_t> &)
+//  - static void DecodeRecord(const uint8_t *&, State &, Record &)
+//
+// Consecutive records with the same RunKey form a run. The run keys are kept next to the body, so logs that only differ in
+// their run keys share equal bodies.
+template <typename Codec>
+class CompactLog {
+  public:
+    using Record = typename Codec::Record;
+    using RunKey = typename Codec::RunKey;
+    static constexpr uint32_t kBlockSize = 32;
+
+    struct Body {
+        std::vector<uint8_t> bytes;
+        // Byte offset of every kBlockSize-th record
+        std::vector<uint32_t> block_offsets;
+        // Index of the first record of each run
+        std::vector<uint32_t> run_starts;
+        uint32_t record_count = 0;
+        size_t hash = 0;
+
+        bool operator==(const Body &other) const {
+            return record_count == other.record_count && run_starts == other.run_starts && bytes == other.bytes;
+        }
+    };
+    struct BodyHash {
+        size_t operator()(const Body &body) const { return body.hash; }
+    };
+    using BodyDictionary = hash_util::WeakDictionary<Body, BodyHash, std::equal_to<Body>>;
+
+    static Body Encode(const std::vector<Record> &log, std::vector<RunKey> &runs);
+
+    CompactLog(std::shared_ptr<const Body> body, std::vector<RunKey> &&runs) : body_(std::move(body)), runs_(std::move(runs)) {}
+    size_t Size() const { return body_->record_count; }
+    const std::shared_ptr<const Body> &GetBody() const { return body_; }
+    Record Decode(uint32_t index) const;
+
+  private:
+    std::shared_ptr<const Body> body_;
+    std::vector<RunKey> runs_;
+};
+
+template <typename Codec>
+typename CompactLog<Codec>::Body CompactLog<Codec>::Encode(const std::vector<Record> &log, std::vector<RunKey> &runs) {
+    Body body;
+    body.record_count = static_cast<uint32_t>(log.size());
+    // Typical records take less than 8 bytes
+    body.bytes.reserve(log.size() * 8);
+    body.block_offsets.reserve(log.size() / kBlockSize + 1);
+
+    typename Codec::State state;
+    for (uint32_t i = 0; i < body.record_count; ++i) {
+        const Record &record = log[i];
+        const RunKey run_key = Codec::GetRunKey(record);
+        if (runs.empty() || !(runs.back() == run_key)) {
+            body.run_starts.push_back(i);
+            runs.emplace_back(run_key);
+        }
+        if (i % kBlockSize == 0) {
+            body.block_offsets.push_back(static_cast<uint32_t>(body.bytes.size()));
+            state = typename Codec::State{};
+        }
+        Codec::EncodeRecord(record, state, body.bytes);
+    }
+    body.bytes.shrink_to_fit();
+    body.hash = hash_util::HashCombiner().Combine(body.bytes).Combine(body.run_starts).Value();
+    return body;
+}
+
+template <typename Codec>
+typename CompactLog<Codec>::Record CompactLog<Codec>::Decode(uint32_t index) const {
+    assert(index < body_->record_count);
+    const auto run = std::upper_bound(body_->run_starts.begin(), body_->run_starts.end(), index);
+    assert(run != body_->run_starts.begin());
+    Record record = Codec::MakeRecord(runs_[std::distance(body_->run_starts.begin(), run) - 1]);
+
+    typename Codec::State state;
+    const uint8_t *data = body_->bytes.data() + body_->block_offsets[index / kBlockSize];
+    for (uint32_t i = index - index % kBlockSize; i <= index; ++i) {
+        Codec::DecodeRecord(data, state, record);
+    }
+    return record;
+}
+
+}  // namespace vvl
@@ -47,4 +47,9 @@ uint64_t Hash64(const void *info, const size_t info_size) {
     return XXH64(info, info_size, seed);
 }
 
+Hash128Value Hash128(const void *info, const size_t info_size) {
+    const XXH128_hash_t hash = XXH3_128bits(info, info_size);
+    return {hash.low64, hash.high64};
+}
+
 }  // namespace hash_util
@@ -22,8 +22,10 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string_view>
 #include <type_traits>
+#include <unordered_map>
 #include <vector>
 #include "containers/custom_containers.h"
 
@@ -158,10 +160,113 @@ class Dictionary {
     Dict dict;
 };
 
+// Like Dictionary, but for canonical data that is looked up often and can be large:
+//  - LookUp hashes and compares the caller's value in place, a copy of it is only made when it is not in the dictionary yet.
+//    Hasher and KeyEqual must accept the lookup type U in addition to T.
+//  - Hits only take a shared lock.
+//  - An entry is removed as soon as the last Id referring to it is released, so the dictionary does not keep every value
+//    ever seen alive.
+template <typename T, typename Hasher, typename KeyEqual>
+class WeakDictionary {
+  public:
+    using Def = T;
+    using Id = std::shared_ptr<const Def>;
+
+    WeakDictionary() : state_(std::make_shared<State>()) {}
+
+    // Find the entry matching value. If there is none, a new one is constructed from args.
+    template <typename U, typename... Args>
+    Id LookUp(const U &value, Args &&...args) {
+        const size_t hash = Hasher()(value);
+        {
+            std::shared_lock<std::shared_mutex> guard(state_->lock);
+            if (Id found = state_->Find(hash, value)) {
+                return found;
+            }
+        }
+        std::unique_ptr<const T> def = std::make_unique<const T>(std::forward<Args>(args)...);
+        std::unique_lock<std::shared_mutex> guard(state_->lock);
+        // Another thread may have added the value while the lock was released
+        if (Id found = state_->Find(hash, value)) {
+            return found;
+        }
+        Id id(def.release(), Deleter{state_, hash});
+        state_->entries.emplace(hash, Entry{id.get(), id});
+        return id;
+    }
+
+    size_t Size() const {
+        std::shared_lock<std::shared_mutex> guard(state_->lock);
+        return state_->entries.size();
+    }
+
+  private:
+    struct Entry {
+        const T *def;
+        std::weak_ptr<const T> id;
+    };
+    struct State {
+        std::shared_mutex lock;
+        std::unordered_multimap<size_t, Entry> entries;
+
+        // lock must be held. The entries can be compared through their raw pointer: a released entry is only deleted after
+        // its deleter removed it from entries, which needs the lock exclusively.
+        template <typename U>
+        Id Find(size_t hash, const U &value) const {
+            auto range = entries.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (KeyEqual()(*it->second.def, value)) {
+                    // Null if the last Id was released and the deleter is waiting for the lock, a new entry is added then
+                    if (Id id = it->second.id.lock()) {
+                        return id;
+                    }
+                }
+            }
+            return nullptr;
+        }
+    };
+    // Keeps the state alive, so Ids may outlive the dictionary
+    struct Deleter {
+        std::shared_ptr<State> state;
+        size_t hash;
+        void operator()(const T *def) const {
+            {
+                std::unique_lock<std::shared_mutex> guard(state->lock);
+                auto range = state->entries.equal_range(hash);
+                for (auto it = range.first; it != range.second; ++it) {
+                    if (it->second.def == def) {
+                        state->entries.erase(it);
+                        break;
+                    }
+                }
+            }
+            delete def;
+        }
+    };
+    std::shared_ptr<State> state_;
+};
+
 uint32_t VuidHash(std::string_view vuid);
 
 uint32_t Hash32(const void *info, const size_t info_size);
 
 uint64_t Hash64(const void *info, const size_t info_size);
 
+// 128-bit XXH3 digest, for content addressing where a collision must be practically impossible
+struct Hash128Value {
+    uint64_t low = 0;
+    uint64_t high = 0;
+
+    bool operator==(const Hash128Value &other) const { return low == other.low && high == other.high; }
+    bool operator!=(const Hash128Value &other) const { return !(*this == other); }
+    bool operator<(const Hash128Value &other) const { return high < other.high || (high == other.high && low < other.low); }
+};
+
+struct Hash128ValueHash {
+    // The digest is already well distributed
+    size_t operator()(const Hash128Value &value) const { return static_cast<size_t>(value.low); }
+};
+
+Hash128Value Hash128(const void *info, const size_t info_size);
+
 }  // namespace hash_util
@@ -0,0 +1,121 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mapped_file.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace vvl {
+
+#if defined(_WIN32)
+
+bool MappedFile::Open(const std::string &path) {
+    Close();
+    // FILE_SHARE_DELETE so the file can still be renamed or deleted while it is mapped. Replacing it with another file
+    // fails until the mapping is closed.
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER file_size = {};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    file_handle_ = file;
+    mapping_handle_ = mapping;
+    data_ = static_cast<const uint8_t *>(view);
+    size_ = static_cast<size_t>(file_size.QuadPart);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_handle_) {
+        CloseHandle(mapping_handle_);
+    }
+    if (file_handle_) {
+        CloseHandle(file_handle_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    file_handle_ = nullptr;
+    mapping_handle_ = nullptr;
+}
+
+#else
+
+bool MappedFile::Open(const std::string &path) {
+    Close();
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void *view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+    if (view == MAP_FAILED) {
+        return false;
+    }
+    data_ = static_cast<const uint8_t *>(view);
+    size_ = static_cast<size_t>(info.st_size);
+    return true;
+}
+
+void MappedFile::Close() {
+    if (data_) {
+        munmap(const_cast<uint8_t *>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
+
+}  // namespace vvl
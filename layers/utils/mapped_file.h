@@ -0,0 +1,52 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace vvl {
+
+// Read-only view of a whole file mapped into memory, so cache files can be consumed in place
+// instead of being streamed into a copy first.
+class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile() { Close(); }
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    // Returns false if the file does not exist, is empty, or can't be mapped
+    bool Open(const std::string &path);
+    void Close();
+
+    bool IsOpen() const { return data_ != nullptr; }
+    const uint8_t *Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+  private:
+    const uint8_t *data_ = nullptr;
+    size_t size_ = 0;
+#if defined(_WIN32)
+    void *file_handle_ = nullptr;
+    void *mapping_handle_ = nullptr;
+#endif
+};
+
+}  // namespace vvl
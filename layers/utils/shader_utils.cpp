@@ -26,13 +26,51 @@
 
 #include "generated/spirv_tools_commit_id.h"
 
+#include <chrono>
 #include <fstream>
 
 // Profiled that having filesystem included in shader_utils.h adds significant compile time to all files
 #include <filesystem>
 namespace fs = std::filesystem;
 
-void ValidationCache::GetUUID(uint8_t *uuid) {
+namespace {
+// 4 bytes for header size + 4 bytes for version number + UUID
+constexpr size_t kValidationCacheHeaderSize = 2 * sizeof(uint32_t) + VK_UUID_SIZE;
+// Part of the UUID, so data written with a different key layout is ignored instead of misread
+constexpr uint32_t kValidationCacheKeyFormat = 2;  // 64-bit XXH3 keys
+// The cache file is only rewritten (sorted) once enough keys have been appended to it
+constexpr size_t kMinAppendedKeysBeforeRewrite = 256;
+}  // namespace
+
+VkValidationCacheEXT ValidationCache::Open(const std::string &path, uint32_t spirv_val_option_hash) {
+    auto cache = new ValidationCache(spirv_val_option_hash);
+    cache->file_path_ = path;
+    if (cache->mapped_file_.Open(path) && cache->IsHeaderCompatible(cache->mapped_file_.Data(), cache->mapped_file_.Size())) {
+        const size_t keys_size = cache->mapped_file_.Size() - kValidationCacheHeaderSize;
+        // The mapping is page aligned and the header size is a multiple of 8, so the keys can be used in place
+        cache->LoadKeys(reinterpret_cast<const uint64_t *>(cache->mapped_file_.Data() + kValidationCacheHeaderSize),
+                        keys_size / sizeof(uint64_t));
+        // A partial key means a write got interrupted, appending after it would misalign every following key
+        cache->file_compatible_ = (keys_size % sizeof(uint64_t)) == 0;
+    }
+    if (cache->file_compatible_) {
+        // Appending is atomic for writes this small, so other processes using the same file can append concurrently
+        cache->append_file_ = std::fopen(path.c_str(), "ab");
+    }
+    return VkValidationCacheEXT(cache);
+}
+
+ValidationCache::~ValidationCache() {
+    if (append_file_) {
+        std::fclose(append_file_);
+    }
+}
+
+uint64_t ValidationCache::GetKey(const uint32_t *code, size_t word_count) {
+    return hash_util::Hash128(code, word_count * sizeof(uint32_t)).low;
+}
+
+void ValidationCache::GetUUID(uint8_t *uuid) const {
     const char *sha1_str = SPIRV_TOOLS_COMMIT_ID;
     // Convert sha1_str from a hex string to binary. We only need VK_UUID_SIZE bytes of
     // output, so pad with zeroes if the input string is shorter than that, and truncate
@@ -51,60 +89,96 @@ void ValidationCache::GetUUID(uint8_t *uuid) {
         uuid[i] = static_cast<uint8_t>(std::strtoul(byte_str, nullptr, 16));
     }
 
-    // Replace the last 4 bytes (likely padded with zero anyway)
+    // Replace the last 8 bytes with the key format and the spirv-val options
+    std::memcpy(uuid + (VK_UUID_SIZE - 2 * sizeof(uint32_t)), &kValidationCacheKeyFormat, sizeof(uint32_t));
     std::memcpy(uuid + (VK_UUID_SIZE - sizeof(uint32_t)), &spirv_val_option_hash_, sizeof(uint32_t));
 }
 
-void ValidationCache::Load(VkValidationCacheCreateInfoEXT const *pCreateInfo) {
-    const auto headerSize = 2 * sizeof(uint32_t) + VK_UUID_SIZE;
-    auto size = headerSize;
-    if (!pCreateInfo->pInitialData || pCreateInfo->initialDataSize < size) return;
+bool ValidationCache::IsHeaderCompatible(const uint8_t *data, size_t size) const {
+    if (!data || size < kValidationCacheHeaderSize) return false;
 
-    uint32_t const *data = (uint32_t const *)pCreateInfo->pInitialData;
-    if (data[0] != size) return;
-    if (data[1] != VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT) return;
+    uint32_t header[2];
+    std::memcpy(header, data, sizeof(header));
+    if (header[0] != kValidationCacheHeaderSize) return false;
+    if (header[1] != VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT) return false;
     uint8_t expected_uuid[VK_UUID_SIZE];
     GetUUID(expected_uuid);
-    if (memcmp(&data[2], expected_uuid, VK_UUID_SIZE) != 0) return;  // different version
+    return std::memcmp(data + sizeof(header), expected_uuid, VK_UUID_SIZE) == 0;  // different version
+}
+
+void ValidationCache::LoadKeys(const uint64_t *keys, size_t key_count) {
+    // Write() always produces sorted keys, anything appended afterwards is usually out of order
+    size_t sorted_count = key_count > 0 ? 1 : 0;
+    while (sorted_count < key_count && keys[sorted_count - 1] < keys[sorted_count]) {
+        sorted_count++;
+    }
+    sorted_keys_ = keys;
+    sorted_key_count_ = sorted_count;
 
-    data = (uint32_t const *)(reinterpret_cast<uint8_t const *>(data) + headerSize);
+    auto guard = WriteLock();
+    added_keys_.reserve(key_count - sorted_count);
+    for (size_t i = sorted_count; i < key_count; i++) {
+        added_keys_.insert(keys[i]);
+    }
+}
+
+void ValidationCache::Load(VkValidationCacheCreateInfoEXT const *pCreateInfo) {
+    const auto *data = static_cast<const uint8_t *>(pCreateInfo->pInitialData);
+    if (!IsHeaderCompatible(data, pCreateInfo->initialDataSize)) return;
+
+    // The application can free pInitialData once the cache is created, and it might not be aligned
+    const size_t key_count = (pCreateInfo->initialDataSize - kValidationCacheHeaderSize) / sizeof(uint64_t);
+    loaded_keys_.resize(key_count);
+    std::memcpy(loaded_keys_.data(), data + kValidationCacheHeaderSize, key_count * sizeof(uint64_t));
+    LoadKeys(loaded_keys_.data(), key_count);
+}
 
+void ValidationCache::Insert(uint64_t key) {
     auto guard = WriteLock();
-    for (; size < pCreateInfo->initialDataSize; data++, size += sizeof(uint32_t)) {
-        good_shader_hashes_.insert(*data);
+    if (!added_keys_.insert(key).second) {
+        return;
+    }
+    if (append_file_) {
+        // Flushed right away so a crash (or another process reading the file) doesn't lose it
+        std::fwrite(&key, sizeof(key), 1, append_file_);
+        std::fflush(append_file_);
     }
 }
 
+std::vector<uint64_t> ValidationCache::GetSortedKeys() const {
+    std::vector<uint64_t> keys;
+    auto guard = ReadLock();
+    keys.reserve(sorted_key_count_ + added_keys_.size());
+    keys.insert(keys.end(), sorted_keys_, sorted_keys_ + sorted_key_count_);
+    const auto added_begin = keys.end() - keys.begin();
+    keys.insert(keys.end(), added_keys_.begin(), added_keys_.end());
+    std::sort(keys.begin() + added_begin, keys.end());
+    std::inplace_merge(keys.begin(), keys.begin() + added_begin, keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
 void ValidationCache::Write(size_t *pDataSize, void *pData) {
-    const auto header_size = 2 * sizeof(uint32_t) + VK_UUID_SIZE;  // 4 bytes for header size + 4 bytes for version number + UUID
+    const std::vector<uint64_t> keys = GetSortedKeys();
     if (!pData) {
-        *pDataSize = header_size + good_shader_hashes_.size() * sizeof(uint32_t);
+        *pDataSize = kValidationCacheHeaderSize + keys.size() * sizeof(uint64_t);
         return;
     }
 
-    if (*pDataSize < header_size) {
+    if (*pDataSize < kValidationCacheHeaderSize) {
         *pDataSize = 0;
         return;  // Too small for even the header!
     }
 
-    uint32_t *out = (uint32_t *)pData;
-    size_t actual_size = header_size;
-
     // Write the header
-    *out++ = header_size;
-    *out++ = VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT;
-    GetUUID(reinterpret_cast<uint8_t *>(out));
-    out = (uint32_t *)(reinterpret_cast<uint8_t *>(out) + VK_UUID_SIZE);
-
-    {
-        auto guard = ReadLock();
-        for (auto it = good_shader_hashes_.begin(); it != good_shader_hashes_.end() && actual_size < *pDataSize;
-             it++, out++, actual_size += sizeof(uint32_t)) {
-            *out = *it;
-        }
-    }
+    auto *out = static_cast<uint8_t *>(pData);
+    const uint32_t header[2] = {static_cast<uint32_t>(kValidationCacheHeaderSize), VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT};
+    std::memcpy(out, header, sizeof(header));
+    GetUUID(out + sizeof(header));
 
-    *pDataSize = actual_size;
+    const size_t key_count = std::min(keys.size(), (*pDataSize - kValidationCacheHeaderSize) / sizeof(uint64_t));
+    std::memcpy(out + kValidationCacheHeaderSize, keys.data(), key_count * sizeof(uint64_t));
+    *pDataSize = kValidationCacheHeaderSize + key_count * sizeof(uint64_t);
 }
 
 void ValidationCache::Merge(ValidationCache const *other) {
@@ -112,10 +186,100 @@ void ValidationCache::Merge(ValidationCache const *other) {
     if (other == this) {
         return;
     }
-    auto other_guard = other->ReadLock();
+    const std::vector<uint64_t> other_keys = other->GetSortedKeys();
+    auto guard = WriteLock();
+    added_keys_.reserve(added_keys_.size() + other_keys.size());
+    std::vector<uint64_t> new_keys;
+    for (uint64_t key : other_keys) {
+        if (!std::binary_search(sorted_keys_, sorted_keys_ + sorted_key_count_, key) && added_keys_.insert(key).second) {
+            new_keys.emplace_back(key);
+        }
+    }
+    if (append_file_ && !new_keys.empty()) {
+        // Same as Insert(), so merged keys are not lost if the file is never rewritten
+        std::fwrite(new_keys.data(), sizeof(uint64_t), new_keys.size(), append_file_);
+        std::fflush(append_file_);
+    }
+}
+
+bool ValidationCache::Flush() {
+    if (file_path_.empty()) {
+        return true;
+    }
+    {
+        auto guard = ReadLock();
+        if (file_compatible_ && added_keys_.size() <= std::max(kMinAppendedKeysBeforeRewrite, sorted_key_count_ / 8)) {
+            return true;  // Appending already made the file up to date
+        }
+    }
+
+    std::vector<uint64_t> keys = GetSortedKeys();
+    // Keep what other processes appended since the file was mapped
+    vvl::MappedFile current_file;
+    if (current_file.Open(file_path_) && IsHeaderCompatible(current_file.Data(), current_file.Size())) {
+        const size_t key_count = (current_file.Size() - kValidationCacheHeaderSize) / sizeof(uint64_t);
+        const auto *current_keys = reinterpret_cast<const uint64_t *>(current_file.Data() + kValidationCacheHeaderSize);
+        keys.insert(keys.end(), current_keys, current_keys + key_count);
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    }
+    current_file.Close();
+
+    std::vector<uint8_t> data(kValidationCacheHeaderSize + keys.size() * sizeof(uint64_t));
+    const uint32_t header[2] = {static_cast<uint32_t>(kValidationCacheHeaderSize), VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT};
+    std::memcpy(data.data(), header, sizeof(header));
+    GetUUID(data.data() + sizeof(header));
+    std::memcpy(data.data() + kValidationCacheHeaderSize, keys.data(), keys.size() * sizeof(uint64_t));
+
+    // Windows can't replace a file this process still has open or mapped, so the keys are moved out of the mapping and both
+    // handles are released before the rename
     auto guard = WriteLock();
-    good_shader_hashes_.reserve(good_shader_hashes_.size() + other->good_shader_hashes_.size());
-    for (auto h : other->good_shader_hashes_) good_shader_hashes_.insert(h);
+    loaded_keys_ = std::move(keys);
+    sorted_keys_ = loaded_keys_.data();
+    sorted_key_count_ = loaded_keys_.size();
+    added_keys_.clear();
+    mapped_file_.Close();
+    if (append_file_) {
+        std::fclose(append_file_);
+        append_file_ = nullptr;
+    }
+
+    const bool replaced = ReplaceFile(data);
+    // Keep appending to whichever file is now in place, as long as it has a layout the keys can be appended to
+    file_compatible_ = replaced || file_compatible_;
+    if (file_compatible_) {
+        append_file_ = std::fopen(file_path_.c_str(), "ab");
+    }
+    return replaced;
+}
+
+bool ValidationCache::ReplaceFile(const std::vector<uint8_t> &data) const {
+    // Write a private file and move it over the old one, so other processes never see a partially written cache.
+    // Anything mapping the old file keeps reading the old contents (on Windows the rename fails while they do, the keys
+    // appended to the old file are kept until a later rewrite succeeds).
+    const uint64_t temp_suffix = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()) ^
+                                 static_cast<uint64_t>(reinterpret_cast<uintptr_t>(this));
+    const std::string temp_path = file_path_ + "." + std::to_string(temp_suffix) + ".tmp";
+    {
+        std::ofstream write_file(temp_path.c_str(), std::ios::out | std::ios::binary);
+        if (!write_file) {
+            return false;
+        }
+        write_file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!write_file) {
+            write_file.close();
+            std::error_code ec;
+            fs::remove(temp_path, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(temp_path, file_path_, ec);
+    if (ec) {
+        fs::remove(temp_path, ec);
+        return false;
+    }
+    return true;
 }
 
 spv_target_env PickSpirvEnv(const APIVersion &api_version, bool spirv_1_4) {
@@ -22,8 +22,12 @@
 
 #include <vulkan/vulkan_core.h>
 #include "utils/vk_layer_utils.h"
+#include "utils/mapped_file.h"
 #include "containers/custom_containers.h"
 
+#include <algorithm>
+#include <cstdio>
+
 #include <spirv-tools/libspirv.hpp>
 
 struct DeviceFeatures;
@@ -69,6 +73,12 @@ inline ShaderObjectStage VkShaderStageToShaderObjectStage(VkShaderStageFlagBits
     return ShaderObjectStage::LAST;
 }
 
+// Set of SPIR-V modules that already passed spirv-val, so they can be skipped.
+//
+// The serialized form is the VK_VALIDATION_CACHE_HEADER_VERSION_ONE_EXT header followed by 64-bit keys. Keys written by
+// Write() are sorted, so loaded data is queried in place with a binary search instead of being rebuilt into a hash set.
+// The device owned cache is backed by a file (see Open()): the file stays memory mapped, and keys validated afterwards are
+// appended to it right away, so several processes can share the same cache file.
 class ValidationCache {
   public:
     static VkValidationCacheEXT Create(VkValidationCacheCreateInfoEXT const *pCreateInfo, uint32_t spirv_val_option_hash) {
@@ -76,38 +86,64 @@ class ValidationCache {
         cache->Load(pCreateInfo);
         return VkValidationCacheEXT(cache);
     }
+    // Creates a cache backed by the file at path, which does not need to exist yet
+    static VkValidationCacheEXT Open(const std::string &path, uint32_t spirv_val_option_hash);
+    ~ValidationCache();
+
+    // Key of a SPIR-V module in the cache (64-bit XXH3)
+    static uint64_t GetKey(const uint32_t *code, size_t word_count);
 
     void Load(VkValidationCacheCreateInfoEXT const *pCreateInfo);
     void Write(size_t *pDataSize, void *pData);
     void Merge(ValidationCache const *other);
-
-    bool Contains(uint32_t hash) {
+    // For file backed caches, rewrites the file with every key sorted if it is missing, out of date, or too much has been
+    // appended to it since it was last sorted. Returns false if the file could not be written.
+    // Must not be called while other threads use the cache, as the loaded keys are moved out of the mapped file.
+    bool Flush();
+
+    bool Contains(uint64_t key) {
+        if (std::binary_search(sorted_keys_, sorted_keys_ + sorted_key_count_, key)) {
+            return true;
+        }
         auto guard = ReadLock();
-        return good_shader_hashes_.count(hash) != 0;
+        return added_keys_.count(key) != 0;
     }
 
-    void Insert(uint32_t hash) {
-        auto guard = WriteLock();
-        good_shader_hashes_.insert(hash);
-    }
+    void Insert(uint64_t key);
 
   private:
     ValidationCache(uint32_t spirv_val_option_hash) : spirv_val_option_hash_(spirv_val_option_hash) {}
     ReadLockGuard ReadLock() const { return ReadLockGuard(lock_); }
     WriteLockGuard WriteLock() { return WriteLockGuard(lock_); }
 
-    void GetUUID(uint8_t *uuid);
+    void GetUUID(uint8_t *uuid) const;
+    bool IsHeaderCompatible(const uint8_t *data, size_t size) const;
+    // Points sorted_keys_ at the leading sorted run of keys, anything after it goes into added_keys_
+    void LoadKeys(const uint64_t *keys, size_t key_count);
+    std::vector<uint64_t> GetSortedKeys() const;
+    // Atomically replaces the cache file with data
+    bool ReplaceFile(const std::vector<uint8_t> &data) const;
 
     // Can hit cases where error appear/disappear if spirv-val settings are adjusted
     // see https://github.com/KhronosGroup/Vulkan-ValidationLayers/issues/8031
     uint32_t spirv_val_option_hash_;
 
-    // hashes of shaders that have passed validation before, and can be skipped.
+    // Keys of shaders that have passed validation before, and can be skipped.
     // we don't store negative results, as we would have to also store what was
     // wrong with them; also, we expect they will get fixed, so we're less
     // likely to see them again.
-    vvl::unordered_set<uint32_t> good_shader_hashes_;
+    // sorted_keys_ is immutable once loaded (points into mapped_file_ or loaded_keys_), so it is read without the lock
+    const uint64_t *sorted_keys_ = nullptr;
+    size_t sorted_key_count_ = 0;
+    std::vector<uint64_t> loaded_keys_;
+    vvl::MappedFile mapped_file_;
+    vvl::unordered_set<uint64_t> added_keys_;
     mutable std::shared_mutex lock_;
+
+    // Only set for file backed caches
+    std::string file_path_;
+    std::FILE *append_file_ = nullptr;
+    bool file_compatible_ = false;
 };
 
 spv_target_env PickSpirvEnv(const APIVersion &api_version, bool spirv_1_4);
@@ -0,0 +1,135 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace vvl {
+
+uint32_t ThreadPool::DefaultWorkerCount() {
+    // The calling thread always takes part in ParallelFor, so leave one core for it.
+    // Past a handful of threads we mostly end up contending on the state tracker maps.
+    constexpr uint32_t kMaxDefaultWorkers = 8;
+    const uint32_t hw_threads = std::thread::hardware_concurrency();
+    return hw_threads > 1 ? std::min(hw_threads - 1, kMaxDefaultWorkers) : 0;
+}
+
+ThreadPool::ThreadPool(uint32_t max_workers) : max_workers_(max_workers) {}
+
+ThreadPool::~ThreadPool() {
+    std::vector<std::thread> workers;
+    {
+        std::unique_lock<std::mutex> guard(lock_);
+        exit_ = true;
+        workers = std::move(workers_);
+    }
+    cond_.notify_all();
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::StartWorkers() {
+    // lock_ must be held
+    if (!workers_.empty()) {
+        return;
+    }
+    const uint32_t worker_count = std::max(max_workers_, 1u);
+    workers_.reserve(worker_count);
+    for (uint32_t i = 0; i < worker_count; ++i) {
+        workers_.emplace_back(&ThreadPool::WorkerFunc, this);
+    }
+}
+
+void ThreadPool::Post(std::function<void()> &&task) {
+    {
+        std::unique_lock<std::mutex> guard(lock_);
+        StartWorkers();
+        tasks_.emplace_back(std::move(task));
+    }
+    cond_.notify_one();
+}
+
+void ThreadPool::WorkerFunc() {
+    std::unique_lock<std::mutex> guard(lock_);
+    while (true) {
+        cond_.wait(guard, [this] { return exit_ || !tasks_.empty(); });
+        if (exit_) {
+            return;
+        }
+        std::function<void()> task = std::move(tasks_.front());
+        tasks_.pop_front();
+        guard.unlock();
+        task();
+        guard.lock();
+    }
+}
+
+void ThreadPool::ParallelFor(uint32_t count, const std::function<void(uint32_t)> &func) {
+    const uint32_t helper_count = std::min(max_workers_, count > 0 ? count - 1 : 0);
+    if (helper_count == 0) {
+        for (uint32_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    // Helpers may only get scheduled after the caller already finished every index, so the shared state is kept alive by
+    // the helpers themselves. func is only dereferenced for an unclaimed index, which means the caller is still waiting.
+    struct Batch {
+        const std::function<void(uint32_t)> *func;
+        uint32_t count;
+        std::atomic<uint32_t> next_index{0};
+        std::atomic<uint32_t> completed{0};
+        std::mutex lock;
+        std::condition_variable done;
+
+        void Run() {
+            uint32_t finished = 0;
+            for (uint32_t i = next_index++; i < count; i = next_index++) {
+                (*func)(i);
+                ++finished;
+            }
+            if (finished != 0 && (completed += finished) == count) {
+                std::unique_lock<std::mutex> guard(lock);
+                done.notify_all();
+            }
+        }
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->func = &func;
+    batch->count = count;
+
+    {
+        std::unique_lock<std::mutex> guard(lock_);
+        StartWorkers();
+        for (uint32_t i = 0; i < helper_count; ++i) {
+            tasks_.emplace_back([batch]() { batch->Run(); });
+        }
+    }
+    cond_.notify_all();
+
+    batch->Run();
+
+    std::unique_lock<std::mutex> guard(batch->lock);
+    batch->done.wait(guard, [&batch]() { return batch->completed.load() == batch->count; });
+}
+
+}  // namespace vvl
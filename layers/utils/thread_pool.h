@@ -0,0 +1,64 @@
+/* Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vvl {
+
+// Small worker pool owned by a device, used to spread independent validation work over several cores and to run
+// background work such as queue retirement. Worker threads are only started the first time work is handed to the pool.
+// There is always at least one worker, max_workers only bounds how many threads ParallelFor fans out to.
+class ThreadPool {
+  public:
+    explicit ThreadPool(uint32_t max_workers = DefaultWorkerCount());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Queue a task to run on one of the worker threads. The task never runs on the calling thread, so it is fine to post
+    // while holding locks the task needs.
+    void Post(std::function<void()> &&task);
+
+    // Calls func(i) for every i in [0, count). The calling thread works through the indices alongside the workers,
+    // so this never waits on work that is queued behind other tasks, and returns once every index has been processed.
+    void ParallelFor(uint32_t count, const std::function<void(uint32_t)> &func);
+
+    uint32_t MaxWorkers() const { return max_workers_; }
+
+    static uint32_t DefaultWorkerCount();
+
+  private:
+    void StartWorkers();
+    void WorkerFunc();
+
+    const uint32_t max_workers_;
+    std::mutex lock_;
+    std::condition_variable cond_;
+    std::deque<std::function<void()>> tasks_;
+    std::vector<std::thread> workers_;
+    bool exit_ = false;
+};
+
+}  // namespace vvl
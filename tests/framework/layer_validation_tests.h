@@ -267,7 +267,8 @@ class DebugPrintfTests : public VkLayerTest {
 struct SyncValSettings;
 class VkSyncValTest : public VkLayerTest {
   public:
-    void InitSyncValFramework(const SyncValSettings *p_sync_settings = nullptr);
+    void InitSyncValFramework(const SyncValSettings *p_sync_settings = nullptr,
+                              const std::vector<VkLayerSettingEXT> &layer_settings = {});
     void InitSyncVal(const SyncValSettings *p_sync_settings = nullptr);
     void InitTimelineSemaphore();
     void InitRayTracing();
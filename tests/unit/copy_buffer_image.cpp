@@ -2754,6 +2754,64 @@ TEST_F(NegativeCopyBufferImage, OverlappingImage) {
     m_command_buffer.End();
 }
 
+TEST_F(NegativeCopyBufferImage, OverlappingImageManyRegions) {
+    TEST_DESCRIPTION("Copy many ranges of an image within the same image, where only a few of them overlap");
+
+    RETURN_IF_SKIP(Init());
+
+    VkImageCreateInfo image_ci = vkt::Image::ImageCreateInfo2D(256, 256, 2, 1, VK_FORMAT_R8G8B8A8_UNORM,
+                                                               VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+    vkt::Image image(*m_device, image_ci);
+
+    std::vector<VkImageCopy> regions;
+    auto add_region = [&regions](uint32_t src_mip, VkOffset3D src_offset, uint32_t dst_mip, VkOffset3D dst_offset,
+                                 VkExtent3D extent) {
+        VkImageCopy region{};
+        region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, src_mip, 0, 1};
+        region.srcOffset = src_offset;
+        region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, dst_mip, 0, 1};
+        region.dstOffset = dst_offset;
+        region.extent = extent;
+        regions.emplace_back(region);
+    };
+    for (int32_t y = 0; y < 64; y += 16) {
+        for (int32_t x = 0; x < 64; x += 16) {
+            // Tiles that touch their neighbors in both the source and destination areas
+            add_region(0, {x, y, 0}, 0, {64 + x, y, 0}, {16, 16, 1});
+        }
+    }
+    for (int32_t y = 64; y < 96; y += 2) {
+        // Stacked rows that all cover the same x range
+        add_region(0, {0, y, 0}, 0, {64, y, 0}, {64, 2, 1});
+    }
+    for (int32_t y = 0; y < 32; y += 8) {
+        for (int32_t x = 0; x < 32; x += 8) {
+            // Same coordinates in another mip level
+            add_region(0, {x, y, 0}, 1, {x, y, 0}, {8, 8, 1});
+        }
+    }
+    const uint32_t overlapped_src = static_cast<uint32_t>(regions.size());
+    add_region(0, {128, 128, 0}, 0, {160, 128, 0}, {16, 16, 1});
+    const uint32_t overlapping_dst = static_cast<uint32_t>(regions.size());
+    add_region(0, {200, 200, 0}, 0, {136, 136, 0}, {16, 16, 1});
+    const uint32_t self_overlap = static_cast<uint32_t>(regions.size());
+    add_region(0, {0, 160, 0}, 0, {8, 168, 0}, {16, 16, 1});
+
+    m_command_buffer.Begin();
+    m_errorMonitor->SetDesiredErrorRegex(
+        "VUID-vkCmdCopyImage-pRegions-00124",
+        "pRegion\\[" + std::to_string(overlapped_src) + "\\] copy source overlaps with pRegions\\[" +
+            std::to_string(overlapping_dst) + "\\]");
+    m_errorMonitor->SetDesiredErrorRegex(
+        "VUID-vkCmdCopyImage-pRegions-00124",
+        "pRegion\\[" + std::to_string(self_overlap) + "\\] copy source overlaps with pRegions\\[" +
+            std::to_string(self_overlap) + "\\]");
+    vk::CmdCopyImage(m_command_buffer, image, VK_IMAGE_LAYOUT_GENERAL, image, VK_IMAGE_LAYOUT_GENERAL,
+                     static_cast<uint32_t>(regions.size()), regions.data());
+    m_errorMonitor->VerifyFound();
+    m_command_buffer.End();
+}
+
 TEST_F(NegativeCopyBufferImage, MinImageTransferGranularity) {
     TEST_DESCRIPTION("Tests for validation of Queue Family property minImageTransferGranularity.");
     RETURN_IF_SKIP(Init());
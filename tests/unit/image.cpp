@@ -612,6 +612,62 @@ TEST_F(NegativeImage, BlitOverlap) {
     m_command_buffer.End();
 }
 
+TEST_F(NegativeImage, BlitOverlapManyRegions) {
+    TEST_DESCRIPTION("Blit many ranges of an image within the same image, where only a mirrored one overlaps");
+
+    RETURN_IF_SKIP(Init());
+
+    VkFormat fmt = VK_FORMAT_R8G8B8A8_UNORM;
+    if (!FormatFeaturesAreSupported(Gpu(), fmt, VK_IMAGE_TILING_OPTIMAL,
+                                    VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT)) {
+        GTEST_SKIP() << "No blit feature format support";
+    }
+
+    VkImageCreateInfo ci =
+        vkt::Image::ImageCreateInfo2D(256, 256, 2, 1, fmt, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+    vkt::Image image(*m_device, ci);
+
+    std::vector<VkImageBlit> regions;
+    auto add_region = [&regions](uint32_t src_mip, VkOffset3D src0, VkOffset3D src1, uint32_t dst_mip, VkOffset3D dst0,
+                                 VkOffset3D dst1) {
+        VkImageBlit region{};
+        region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, src_mip, 0, 1};
+        region.srcOffsets[0] = src0;
+        region.srcOffsets[1] = src1;
+        region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, dst_mip, 0, 1};
+        region.dstOffsets[0] = dst0;
+        region.dstOffsets[1] = dst1;
+        regions.emplace_back(region);
+    };
+    for (int32_t y = 0; y < 64; y += 16) {
+        for (int32_t x = 0; x < 64; x += 16) {
+            // Tiles that touch their neighbors, mirrored along x
+            add_region(0, {x, y, 0}, {x + 16, y + 16, 1}, 0, {64 + x + 16, y, 0}, {64 + x, y + 16, 1});
+        }
+    }
+    for (int32_t y = 64; y < 96; y += 2) {
+        // Stacked rows that all cover the same x range, mirrored along y
+        add_region(0, {0, y, 0}, {64, y + 2, 1}, 0, {64, y + 2, 0}, {128, y, 1});
+    }
+    for (int32_t y = 0; y < 64; y += 16) {
+        for (int32_t x = 0; x < 64; x += 16) {
+            // Downsampled into the same coordinates of the next mip level
+            add_region(0, {x, y, 0}, {x + 16, y + 16, 1}, 1, {x / 2, y / 2, 0}, {x / 2 + 8, y / 2 + 8, 1});
+        }
+    }
+    const uint32_t mirrored_overlap = static_cast<uint32_t>(regions.size());
+    add_region(0, {128, 128, 0}, {160, 160, 1}, 0, {150, 128, 0}, {118, 160, 1});
+
+    m_command_buffer.Begin();
+    m_errorMonitor->SetDesiredErrorRegex("VUID-vkCmdBlitImage-pRegions-00217",
+                                         "pRegion\\[" + std::to_string(mirrored_overlap) + "\\] src overlaps with pRegions\\[" +
+                                             std::to_string(mirrored_overlap) + "\\] dst");
+    vk::CmdBlitImage(m_command_buffer, image, VK_IMAGE_LAYOUT_GENERAL, image, VK_IMAGE_LAYOUT_GENERAL,
+                     static_cast<uint32_t>(regions.size()), regions.data(), VK_FILTER_NEAREST);
+    m_errorMonitor->VerifyFound();
+    m_command_buffer.End();
+}
+
 TEST_F(NegativeImage, MiscBlitTests) {
     RETURN_IF_SKIP(Init());
 
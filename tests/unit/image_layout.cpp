@@ -1035,3 +1035,93 @@ TEST_F(NegativeImageLayout, LayoutTransitionRenderPassObject2) {
     m_command_buffer.EndRenderPass();
     m_command_buffer.End();
 }
+
+TEST_F(NegativeImageLayout, ResubmitAfterLayoutChangeBySubmit) {
+    TEST_DESCRIPTION("Submit a command buffer again after another submission changed the layout it expects");
+    RETURN_IF_SKIP(Init());
+
+    vkt::Image image(*m_device, 32, 32, VK_FORMAT_R8G8B8A8_UNORM,
+                     VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+    image.SetLayout(VK_IMAGE_LAYOUT_GENERAL);
+    const VkImageSubresourceRange range = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1};
+
+    // Expects GENERAL and leaves the image in GENERAL, so it can be submitted repeatedly
+    const VkImageMemoryBarrier barriers[2] = {
+        image.ImageMemoryBarrier(0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                 range),
+        image.ImageMemoryBarrier(VK_ACCESS_TRANSFER_WRITE_BIT, 0, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_GENERAL,
+                                 range)};
+    m_command_buffer.Begin();
+    vk::CmdPipelineBarrier(m_command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr,
+                           0, nullptr, 1, &barriers[0]);
+    vk::CmdPipelineBarrier(m_command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr,
+                           0, nullptr, 1, &barriers[1]);
+    m_command_buffer.End();
+
+    vkt::CommandBuffer transition_cb(*m_device, m_command_pool);
+    transition_cb.Begin();
+    image.ImageMemoryBarrier(transition_cb, 0, 0, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+    transition_cb.End();
+
+    m_default_queue->SubmitAndWait(m_command_buffer);
+    m_default_queue->SubmitAndWait(m_command_buffer);
+    m_default_queue->SubmitAndWait(transition_cb);
+
+    m_errorMonitor->SetDesiredError("VUID-vkCmdDraw-None-09600");
+    m_default_queue->Submit(m_command_buffer);
+    m_errorMonitor->VerifyFound();
+    m_default_queue->Wait();
+}
+
+TEST_F(NegativeImageLayout, ResubmitAfterLayoutChangeManyImages) {
+    TEST_DESCRIPTION("Submit a command buffer using many images again after another submission changed some of their layouts");
+    RETURN_IF_SKIP(Init());
+
+    // Enough images for the submit time layout checks to be split across threads
+    constexpr uint32_t kImageCount = 24;
+    const VkImageSubresourceRange range = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 2};
+    VkImageCreateInfo image_ci = vkt::Image::ImageCreateInfo2D(
+        16, 16, 1, 2, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT);
+    std::vector<std::unique_ptr<vkt::Image>> images;
+    std::vector<VkImageMemoryBarrier> to_transfer;
+    std::vector<VkImageMemoryBarrier> to_general;
+    for (uint32_t i = 0; i < kImageCount; ++i) {
+        images.emplace_back(std::make_unique<vkt::Image>(*m_device, image_ci));
+        images.back()->SetLayout(VK_IMAGE_LAYOUT_GENERAL);
+        to_transfer.emplace_back(images.back()->ImageMemoryBarrier(0, VK_ACCESS_TRANSFER_WRITE_BIT, VK_IMAGE_LAYOUT_GENERAL,
+                                                                   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, range));
+        to_general.emplace_back(images.back()->ImageMemoryBarrier(
+            VK_ACCESS_TRANSFER_WRITE_BIT, 0, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_GENERAL, range));
+    }
+
+    m_command_buffer.Begin();
+    vk::CmdPipelineBarrier(m_command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr,
+                           0, nullptr, kImageCount, to_transfer.data());
+    vk::CmdPipelineBarrier(m_command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr,
+                           0, nullptr, kImageCount, to_general.data());
+    m_command_buffer.End();
+
+    // Moves the second layer of most of the images out of GENERAL, so that the images whose layouts changed are still enough
+    // to be checked in parallel
+    const VkImageSubresourceRange second_layer = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 1, 1};
+    std::vector<VkImageMemoryBarrier> changes;
+    for (uint32_t i = 0; i < kImageCount; ++i) {
+        if (i % 4 == 3) continue;
+        changes.emplace_back(
+            images[i]->ImageMemoryBarrier(0, 0, VK_IMAGE_LAYOUT_GENERAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, second_layer));
+    }
+    vkt::CommandBuffer transition_cb(*m_device, m_command_pool);
+    transition_cb.Begin();
+    vk::CmdPipelineBarrier(transition_cb, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0,
+                           nullptr, static_cast<uint32_t>(changes.size()), changes.data());
+    transition_cb.End();
+
+    m_default_queue->SubmitAndWait(m_command_buffer);
+    m_default_queue->SubmitAndWait(m_command_buffer);
+    m_default_queue->SubmitAndWait(transition_cb);
+
+    m_errorMonitor->SetDesiredError("VUID-vkCmdDraw-None-09600", static_cast<uint32_t>(changes.size()));
+    m_default_queue->Submit(m_command_buffer);
+    m_errorMonitor->VerifyFound();
+    m_default_queue->Wait();
+}
@@ -74,6 +74,11 @@ TEST_F(PositiveLayerSettings, AllSettings) {
         {OBJECT_LAYER_NAME, "syncval_submit_time_validation", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &disable},
         {OBJECT_LAYER_NAME, "syncval_shader_accesses_heuristic", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &disable},
         {OBJECT_LAYER_NAME, "syncval_message_extra_properties", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &disable},
+        {OBJECT_LAYER_NAME, "syncval_max_retained_submits", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &one_k},
+        {OBJECT_LAYER_NAME, "syncval_max_retained_history_mb", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &one_k},
+        {OBJECT_LAYER_NAME, "syncval_telemetry", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &disable},
+        {OBJECT_LAYER_NAME, "syncval_telemetry_report_interval", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &one_k},
+        {OBJECT_LAYER_NAME, "syncval_telemetry_filename", VK_LAYER_SETTING_TYPE_STRING_EXT, 1, &some_string},
         {OBJECT_LAYER_NAME, "message_format_display_application_name", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &disable},
         {OBJECT_LAYER_NAME, "message_format_json", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &disable},
         {OBJECT_LAYER_NAME, "debug_action", VK_LAYER_SETTING_TYPE_STRING_EXT, 1, &action_ignore},
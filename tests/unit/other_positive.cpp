@@ -699,3 +699,48 @@ TEST_F(VkPositiveLayerTest, PhysicalDeviceLayeredApiVulkanProperties) {
     VkPhysicalDeviceProperties2 phys_dev_props_2 = vku::InitStructHelper(&api_prop_lists);
     vk::GetPhysicalDeviceProperties2(Gpu(), &phys_dev_props_2);
 }
+
+TEST_F(VkPositiveLayerTest, ValidationCacheRoundTrip) {
+    TEST_DESCRIPTION("Shaders added to a validation cache survive getting its data and creating a new cache from it");
+    AddRequiredExtensions(VK_EXT_VALIDATION_CACHE_EXTENSION_NAME);
+    RETURN_IF_SKIP(Init());
+
+    VkValidationCacheCreateInfoEXT cache_ci = vku::InitStructHelper();
+    VkValidationCacheEXT cache = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vk::CreateValidationCacheEXT(device(), &cache_ci, nullptr, &cache));
+
+    size_t empty_size = 0;
+    vk::GetValidationCacheDataEXT(device(), cache, &empty_size, nullptr);
+
+    const std::vector<uint32_t> spv = GLSLToSPV(VK_SHADER_STAGE_COMPUTE_BIT, "#version 450\nvoid main() {}");
+    VkShaderModuleValidationCacheCreateInfoEXT module_cache_ci = vku::InitStructHelper();
+    module_cache_ci.validationCache = cache;
+    VkShaderModuleCreateInfo module_ci = vku::InitStructHelper(&module_cache_ci);
+    module_ci.codeSize = spv.size() * sizeof(uint32_t);
+    module_ci.pCode = spv.data();
+    VkShaderModule module = VK_NULL_HANDLE;
+    vk::CreateShaderModule(device(), &module_ci, nullptr, &module);
+    vk::DestroyShaderModule(device(), module, nullptr);
+
+    // One 64-bit key per validated module
+    size_t data_size = 0;
+    vk::GetValidationCacheDataEXT(device(), cache, &data_size, nullptr);
+    ASSERT_EQ(empty_size + sizeof(uint64_t), data_size);
+    std::vector<uint8_t> data(data_size);
+    ASSERT_EQ(VK_SUCCESS, vk::GetValidationCacheDataEXT(device(), cache, &data_size, data.data()));
+
+    VkValidationCacheCreateInfoEXT loaded_cache_ci = vku::InitStructHelper();
+    loaded_cache_ci.initialDataSize = data.size();
+    loaded_cache_ci.pInitialData = data.data();
+    VkValidationCacheEXT loaded_cache = VK_NULL_HANDLE;
+    ASSERT_EQ(VK_SUCCESS, vk::CreateValidationCacheEXT(device(), &loaded_cache_ci, nullptr, &loaded_cache));
+
+    // Merging the same key back in must not duplicate it
+    ASSERT_EQ(VK_SUCCESS, vk::MergeValidationCachesEXT(device(), loaded_cache, 1, &cache));
+    size_t loaded_size = 0;
+    vk::GetValidationCacheDataEXT(device(), loaded_cache, &loaded_size, nullptr);
+    ASSERT_EQ(data_size, loaded_size);
+
+    vk::DestroyValidationCacheEXT(device(), loaded_cache, nullptr);
+    vk::DestroyValidationCacheEXT(device(), cache, nullptr);
+}
@@ -2441,6 +2441,37 @@ TEST_F(NegativePipeline, CreateComputePipelineWithDerivatives) {
     }
 }
 
+TEST_F(NegativePipeline, CreateComputePipelinesBatchDerivatives) {
+    TEST_DESCRIPTION("Large batches of create infos can be validated on several threads, make sure every error is still reported");
+
+    RETURN_IF_SKIP(Init());
+
+    VkShaderObj cs(this, kMinimalShaderGlsl, VK_SHADER_STAGE_COMPUTE_BIT);
+    const vkt::PipelineLayout pipeline_layout(*m_device, {});
+
+    constexpr uint32_t pipeline_count = 16;
+    std::vector<VkComputePipelineCreateInfo> compute_create_infos(pipeline_count);
+    for (uint32_t i = 0; i < pipeline_count; i++) {
+        compute_create_infos[i] = vku::InitStructHelper();
+        compute_create_infos[i].stage = cs.GetStageCreateInfo();
+        compute_create_infos[i].layout = pipeline_layout;
+        compute_create_infos[i].basePipelineIndex = -1;
+        // Every odd pipeline derives from the previous one, which lacks VK_PIPELINE_CREATE_ALLOW_DERIVATIVES_BIT
+        if (i % 2 == 1) {
+            compute_create_infos[i].flags = VK_PIPELINE_CREATE_DERIVATIVE_BIT;
+            compute_create_infos[i].basePipelineIndex = static_cast<int32_t>(i - 1);
+        }
+    }
+
+    m_errorMonitor->SetDesiredError("VUID-vkCreateComputePipelines-flags-00696", pipeline_count / 2);
+    std::vector<VkPipeline> pipelines(pipeline_count, VK_NULL_HANDLE);
+    vk::CreateComputePipelines(device(), VK_NULL_HANDLE, pipeline_count, compute_create_infos.data(), nullptr, pipelines.data());
+    m_errorMonitor->VerifyFound();
+    for (auto pipeline : pipelines) {
+        vk::DestroyPipeline(device(), pipeline, nullptr);
+    }
+}
+
 TEST_F(NegativePipeline, GraphicsPipelineWithBadBasePointer) {
     TEST_DESCRIPTION("Create Graphics Pipeline with bad base pointer");
 
@@ -1918,3 +1918,38 @@ TEST_F(PositivePipeline, GetPipelinePropertiesEXT) {
     VkBaseOutStructure out_struct = {VK_STRUCTURE_TYPE_PIPELINE_PROPERTIES_IDENTIFIER_EXT, nullptr};
     vk::GetPipelinePropertiesEXT(device(), &pipeline_info, &out_struct);
 }
+
+TEST_F(PositivePipeline, SharedFixedFunctionState) {
+    TEST_DESCRIPTION("Pipelines with identical blend/multisample/depth-stencil state share it, make sure it outlives the first one");
+    RETURN_IF_SKIP(Init());
+    InitRenderTarget();
+
+    VkPipelineDepthStencilStateCreateInfo ds_ci = vku::InitStructHelper();
+    ds_ci.depthTestEnable = VK_FALSE;
+
+    CreatePipelineHelper pipe0(*this);
+    pipe0.gp_ci_.pDepthStencilState = &ds_ci;
+    pipe0.CreateGraphicsPipeline();
+
+    CreatePipelineHelper pipe1(*this);
+    pipe1.gp_ci_.pDepthStencilState = &ds_ci;
+    pipe1.CreateGraphicsPipeline();
+
+    // Same states, except for the blend constants being used
+    CreatePipelineHelper pipe2(*this);
+    pipe2.gp_ci_.pDepthStencilState = &ds_ci;
+    pipe2.cb_attachments_.blendEnable = VK_TRUE;
+    pipe2.cb_attachments_.srcColorBlendFactor = VK_BLEND_FACTOR_CONSTANT_COLOR;
+    pipe2.CreateGraphicsPipeline();
+
+    pipe0.Destroy();
+
+    m_command_buffer.Begin();
+    m_command_buffer.BeginRenderPass(m_renderPassBeginInfo);
+    vk::CmdBindPipeline(m_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe1.Handle());
+    vk::CmdDraw(m_command_buffer, 3, 1, 0, 0);
+    vk::CmdBindPipeline(m_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe2.Handle());
+    vk::CmdDraw(m_command_buffer, 3, 1, 0, 0);
+    m_command_buffer.EndRenderPass();
+    m_command_buffer.End();
+}
@@ -1846,6 +1846,60 @@ TEST_F(NegativeShaderSpirv, NoUniformBufferStandardLayout10) {
     m_errorMonitor->VerifyFound();
 }
 
+TEST_F(NegativeShaderSpirv, AsyncSpirvValidation) {
+    TEST_DESCRIPTION("With check_shaders_async, spirv-val errors are reported when the shader module is first used");
+    SetTargetApiVersion(VK_API_VERSION_1_0);
+
+    const VkBool32 async_spirv_val = VK_TRUE;
+    const VkLayerSettingEXT setting = {OBJECT_LAYER_NAME, "check_shaders_async", VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1,
+                                       &async_spirv_val};
+    VkLayerSettingsCreateInfoEXT layer_settings_create_info = vku::InitStructHelper();
+    layer_settings_create_info.settingCount = 1;
+    layer_settings_create_info.pSettings = &setting;
+    RETURN_IF_SKIP(InitFramework(&layer_settings_create_info));
+    RETURN_IF_SKIP(InitState());
+    if (DeviceValidationVersion() > VK_API_VERSION_1_0) {
+        GTEST_SKIP() << "Tests for 1.0 only";
+    }
+
+    // std430 uniform block without uniformBufferStandardLayout
+    const char *spv_source = R"(
+               OpCapability Shader
+          %1 = OpExtInstImport "GLSL.std.450"
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint GLCompute %main "main"
+               OpExecutionMode %main LocalSize 1 1 1
+               OpSource GLSL 450
+               OpDecorate %_arr_float_uint_8 ArrayStride 4
+               OpMemberDecorate %ubo430 0 Offset 0
+               OpDecorate %ubo430 Block
+               OpDecorate %_ DescriptorSet 0
+               OpDecorate %_ Binding 0
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+       %uint = OpTypeInt 32 0
+     %uint_8 = OpConstant %uint 8
+%_arr_float_uint_8 = OpTypeArray %float %uint_8
+     %ubo430 = OpTypeStruct %_arr_float_uint_8
+%_ptr_Uniform_ubo430 = OpTypePointer Uniform %ubo430
+          %_ = OpVariable %_ptr_Uniform_ubo430 Uniform
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+               OpReturn
+               OpFunctionEnd
+        )";
+
+    // Nothing is reported while the module is created
+    CreateComputePipelineHelper pipe(*this);
+    pipe.cs_ = VkShaderObj::CreateFromASM(this, spv_source, VK_SHADER_STAGE_COMPUTE_BIT);
+    pipe.dsl_bindings_[0] = {0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+
+    m_errorMonitor->SetDesiredError("VUID-VkShaderModuleCreateInfo-pCode-08737");
+    pipe.CreateComputePipeline();
+    m_errorMonitor->VerifyFound();
+}
+
 TEST_F(NegativeShaderSpirv, NoUniformBufferStandardLayout12) {
     TEST_DESCRIPTION(
         "Don't enable uniformBufferStandardLayout in Vulkan1.2 when VK_KHR_uniform_buffer_standard_layout was promoted");
@@ -2757,4 +2811,65 @@ TEST_F(NegativeShaderSpirv, ShaderRelaxedExtendedInstruction) {
     m_errorMonitor->SetDesiredError("UNASSIGNED-RuntimeSpirv-shaderRelaxedExtendedInstruction");
     VkShaderObj cs(this, spv_source, VK_SHADER_STAGE_COMPUTE_BIT, SPV_ENV_VULKAN_1_0, SPV_SOURCE_ASM);
     m_errorMonitor->VerifyFound();
-}
\ No newline at end of file
+}
+TEST_F(NegativeShaderSpirv, IdenticalModulesSharedReflection) {
+    TEST_DESCRIPTION("Identical SPIR-V shares the parsed data, make sure every module created from it is reflected correctly");
+    RETURN_IF_SKIP(Init());
+    InitRenderTarget();
+
+    char const *vs_source = R"glsl(
+        #version 450
+        layout (std140, set = 0, binding = 0) uniform buf {
+            mat4 mvp;
+        } ubuf;
+        void main(){
+           gl_Position = ubuf.mvp * vec4(1);
+        }
+    )glsl";
+
+    // The uniform buffer is not visible to the vertex stage
+    OneOffDescriptorSet ds(m_device, {{0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr}});
+    vkt::PipelineLayout pipeline_layout(*m_device, {&ds.layout_});
+
+    auto vs0 = std::make_unique<VkShaderObj>(this, vs_source, VK_SHADER_STAGE_VERTEX_BIT);
+    VkShaderObj vs1(this, vs_source, VK_SHADER_STAGE_VERTEX_BIT);
+
+    {
+        CreatePipelineHelper pipe(*this);
+        pipe.shader_stages_ = {vs0->GetStageCreateInfo(), pipe.fs_->GetStageCreateInfo()};
+        pipe.gp_ci_.layout = pipeline_layout;
+        m_errorMonitor->SetDesiredError("VUID-VkGraphicsPipelineCreateInfo-layout-07988");
+        pipe.CreateGraphicsPipeline();
+        m_errorMonitor->VerifyFound();
+    }
+    {
+        CreatePipelineHelper pipe(*this);
+        pipe.shader_stages_ = {vs1.GetStageCreateInfo(), pipe.fs_->GetStageCreateInfo()};
+        pipe.gp_ci_.layout = pipeline_layout;
+        m_errorMonitor->SetDesiredError("VUID-VkGraphicsPipelineCreateInfo-layout-07988");
+        pipe.CreateGraphicsPipeline();
+        m_errorMonitor->VerifyFound();
+    }
+
+    // The parsed data must outlive the first module created from it
+    vs0.reset();
+    {
+        CreatePipelineHelper pipe(*this);
+        pipe.shader_stages_ = {vs1.GetStageCreateInfo(), pipe.fs_->GetStageCreateInfo()};
+        pipe.gp_ci_.layout = pipeline_layout;
+        m_errorMonitor->SetDesiredError("VUID-VkGraphicsPipelineCreateInfo-layout-07988");
+        pipe.CreateGraphicsPipeline();
+        m_errorMonitor->VerifyFound();
+    }
+
+    // A module created after the first one was destroyed finds the parsed data of vs1
+    VkShaderObj vs2(this, vs_source, VK_SHADER_STAGE_VERTEX_BIT);
+    {
+        CreatePipelineHelper pipe(*this);
+        pipe.shader_stages_ = {vs2.GetStageCreateInfo(), pipe.fs_->GetStageCreateInfo()};
+        pipe.gp_ci_.layout = pipeline_layout;
+        m_errorMonitor->SetDesiredError("VUID-VkGraphicsPipelineCreateInfo-layout-07988");
+        pipe.CreateGraphicsPipeline();
+        m_errorMonitor->VerifyFound();
+    }
+}
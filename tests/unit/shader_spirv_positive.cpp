@@ -2244,4 +2244,30 @@ TEST_F(PositiveShaderSpirv, ShaderRelaxedExtendedInstruction) {
         )";
 
     VkShaderObj cs(this, spv_source, VK_SHADER_STAGE_COMPUTE_BIT, SPV_ENV_VULKAN_1_0, SPV_SOURCE_ASM);
-}
\ No newline at end of file
+}
+
+TEST_F(PositiveShaderSpirv, IdenticalModulesSharedReflection) {
+    TEST_DESCRIPTION("Identical SPIR-V shares the parsed data, make sure it outlives the first module using it");
+    RETURN_IF_SKIP(Init());
+    InitRenderTarget();
+
+    auto fs0 = std::make_unique<VkShaderObj>(this, kFragmentMinimalGlsl, VK_SHADER_STAGE_FRAGMENT_BIT);
+    VkShaderObj fs1(this, kFragmentMinimalGlsl, VK_SHADER_STAGE_FRAGMENT_BIT);
+
+    CreatePipelineHelper pipe0(*this);
+    pipe0.shader_stages_ = {pipe0.vs_->GetStageCreateInfo(), fs0->GetStageCreateInfo()};
+    pipe0.CreateGraphicsPipeline();
+    pipe0.Destroy();
+    fs0.reset();
+
+    CreatePipelineHelper pipe1(*this);
+    pipe1.shader_stages_ = {pipe1.vs_->GetStageCreateInfo(), fs1.GetStageCreateInfo()};
+    pipe1.CreateGraphicsPipeline();
+
+    m_command_buffer.Begin();
+    m_command_buffer.BeginRenderPass(m_renderPassBeginInfo);
+    vk::CmdBindPipeline(m_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe1.Handle());
+    vk::CmdDraw(m_command_buffer, 3, 1, 0, 0);
+    m_command_buffer.EndRenderPass();
+    m_command_buffer.End();
+}
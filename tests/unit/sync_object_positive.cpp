@@ -468,6 +468,34 @@ TEST_F(PositiveSyncObject, TwoQueuesEnsureCorrectRetirementWithWorkStolen) {
     m_device->Wait();
 }
 
+TEST_F(PositiveSyncObject, SemaphoreChainAcrossAllQueues) {
+    TEST_DESCRIPTION("Chain submissions through every queue, the fence wait has to retire all queues in order");
+    all_queue_count_ = true;
+    RETURN_IF_SKIP(Init());
+    const std::vector<vkt::Queue *> &queues = m_device->QueuesWithTransferCapability();
+    if (queues.size() < 2) {
+        GTEST_SKIP() << "Test requires two queues";
+    }
+
+    constexpr uint32_t kRounds = 8;
+    std::vector<vkt::Semaphore> semaphores;
+    semaphores.reserve(kRounds * queues.size());
+    for (uint32_t round = 0; round < kRounds; ++round) {
+        for (vkt::Queue *queue : queues) {
+            semaphores.emplace_back(*m_device);
+            if (semaphores.size() == 1) {
+                queue->Submit(vkt::no_cmd, vkt::Signal(semaphores.back()));
+            } else {
+                queue->Submit(vkt::no_cmd, vkt::Wait(semaphores[semaphores.size() - 2]), vkt::Signal(semaphores.back()));
+            }
+        }
+    }
+    vkt::Fence fence(*m_device);
+    queues.front()->Submit(vkt::no_cmd, vkt::Wait(semaphores.back()), fence);
+    fence.Wait(kWaitTimeout);
+    m_device->Wait();
+}
+
 TEST_F(PositiveSyncObject, TwoQueueSubmitsSeparateQueuesWithSemaphoreAndOneFence) {
     TEST_DESCRIPTION(
         "Two command buffers, each in a separate QueueSubmit call submitted on separate queues, the second having a fence, "
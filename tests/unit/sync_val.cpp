@@ -76,6 +76,82 @@ TEST_F(NegativeSyncVal, BufferCopy) {
     m_command_buffer.End();
 }
 
+TEST_F(NegativeSyncVal, GlobalBarrierAcrossRanges) {
+    TEST_DESCRIPTION("Global barrier does not protect a write that spans several previously written ranges");
+    RETURN_IF_SKIP(InitSyncVal());
+
+    vkt::Buffer buffer_src(*m_device, 768, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    vkt::Buffer buffer(*m_device, 768, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+    vkt::Buffer buffer_dst(*m_device, 768, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+
+    VkMemoryBarrier mem_barrier = vku::InitStructHelper();
+    mem_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    mem_barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+    m_command_buffer.Begin();
+    // Write three separate ranges
+    for (VkDeviceSize offset = 0; offset < 768; offset += 256) {
+        VkBufferCopy region = {offset, offset, 256};
+        vk::CmdCopyBuffer(m_command_buffer, buffer_src, buffer, 1, &region);
+    }
+    vk::CmdPipelineBarrier(m_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &mem_barrier, 0,
+                           nullptr, 0, nullptr);
+
+    // The barrier makes the writes visible to reads of the first two ranges
+    VkBufferCopy read_region = {0, 0, 512};
+    vk::CmdCopyBuffer(m_command_buffer, buffer, buffer_dst, 1, &read_region);
+
+    // But not to a write that covers the last two ranges
+    VkBufferCopy write_region = {256, 256, 512};
+    m_errorMonitor->SetDesiredError("SYNC-HAZARD-WRITE-AFTER-WRITE");
+    vk::CmdCopyBuffer(m_command_buffer, buffer_src, buffer, 1, &write_region);
+    m_errorMonitor->VerifyFound();
+
+    // Chain a second global barrier that protects the write
+    mem_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    mem_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    vk::CmdPipelineBarrier(m_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &mem_barrier, 0,
+                           nullptr, 0, nullptr);
+    vk::CmdCopyBuffer(m_command_buffer, buffer_src, buffer, 1, &write_region);
+    m_command_buffer.End();
+}
+
+TEST_F(NegativeSyncVal, SuppressedHazards) {
+    TEST_DESCRIPTION("Hazard types filtered by message_id_filter or over duplicate_message_limit are not reported");
+    const char *filtered_ids = "SYNC-HAZARD-WRITE-AFTER-WRITE";
+    const uint32_t duplicate_limit = 2;
+    const std::vector<VkLayerSettingEXT> layer_settings = {
+        {OBJECT_LAYER_NAME, "message_id_filter", VK_LAYER_SETTING_TYPE_STRING_EXT, 1, &filtered_ids},
+        {OBJECT_LAYER_NAME, "duplicate_message_limit", VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &duplicate_limit}};
+    RETURN_IF_SKIP(InitSyncValFramework(nullptr, layer_settings));
+    RETURN_IF_SKIP(InitState());
+
+    const VkBufferUsageFlags usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    vkt::Buffer buffer_a(*m_device, 256, usage);
+    vkt::Buffer buffer_b(*m_device, 256, usage);
+    vkt::Buffer buffer_c(*m_device, 256, usage);
+    vkt::Buffer buffer_d(*m_device, 256, usage);
+    vkt::Buffer buffer_e(*m_device, 256, usage);
+    vkt::Buffer buffer_f(*m_device, 256, usage);
+
+    m_command_buffer.Begin();
+    m_command_buffer.Copy(buffer_a, buffer_b);
+    // WRITE_AFTER_WRITE is filtered
+    m_command_buffer.Copy(buffer_c, buffer_b);
+
+    // Other hazard types are still reported, until the duplicate message limit is reached
+    m_errorMonitor->SetDesiredError("SYNC-HAZARD-READ-AFTER-WRITE");
+    m_command_buffer.Copy(buffer_b, buffer_d);
+    m_errorMonitor->VerifyFound();
+    m_errorMonitor->SetDesiredError("SYNC-HAZARD-READ-AFTER-WRITE");
+    m_command_buffer.Copy(buffer_b, buffer_e);
+    m_errorMonitor->VerifyFound();
+
+    // READ_AFTER_WRITE reached the limit, so it is no longer reported
+    m_command_buffer.Copy(buffer_b, buffer_f);
+    m_command_buffer.End();
+}
+
 TEST_F(NegativeSyncVal, BufferCopyWrongBarrier) {
     TEST_DESCRIPTION("Buffer barrier does not specify proper dst stage/access");
     SetTargetApiVersion(VK_API_VERSION_1_3);
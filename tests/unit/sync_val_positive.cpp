@@ -30,8 +30,9 @@ static const std::array syncval_disables = {
     VK_VALIDATION_FEATURE_DISABLE_OBJECT_LIFETIMES_EXT, VK_VALIDATION_FEATURE_DISABLE_CORE_CHECKS_EXT};
 
 
-void VkSyncValTest::InitSyncValFramework(const SyncValSettings *p_sync_settings) {
-    std::vector<VkLayerSettingEXT> settings;
+void VkSyncValTest::InitSyncValFramework(const SyncValSettings *p_sync_settings,
+                                         const std::vector<VkLayerSettingEXT> &layer_settings) {
+    std::vector<VkLayerSettingEXT> settings = layer_settings;
 
     static const SyncValSettings test_default_sync_settings = [] {
         // That's a separate set of defaults for testing purposes.
@@ -52,6 +53,15 @@ void VkSyncValTest::InitSyncValFramework(const SyncValSettings *p_sync_settings)
     settings.emplace_back(VkLayerSettingEXT{OBJECT_LAYER_NAME, "syncval_shader_accesses_heuristic",
                                             VK_LAYER_SETTING_TYPE_BOOL32_EXT, 1, &shader_accesses_heuristic});
 
+    if (sync_settings.max_retained_submits != 0) {
+        settings.emplace_back(VkLayerSettingEXT{OBJECT_LAYER_NAME, "syncval_max_retained_submits", VK_LAYER_SETTING_TYPE_UINT32_EXT,
+                                                1, &sync_settings.max_retained_submits});
+    }
+    if (sync_settings.max_retained_history_mb != 0) {
+        settings.emplace_back(VkLayerSettingEXT{OBJECT_LAYER_NAME, "syncval_max_retained_history_mb",
+                                                VK_LAYER_SETTING_TYPE_UINT32_EXT, 1, &sync_settings.max_retained_history_mb});
+    }
+
     VkLayerSettingsCreateInfoEXT settings_create_info = vku::InitStructHelper();
     settings_create_info.settingCount = size32(settings);
     settings_create_info.pSettings = settings.data();
@@ -110,6 +120,33 @@ TEST_F(PositiveSyncVal, BufferCopyNonOverlappedRegions) {
     m_command_buffer.End();
 }
 
+TEST_F(PositiveSyncVal, ManyGlobalBarriers) {
+    TEST_DESCRIPTION("Chain of global barriers, more than are kept pending before they are applied to all accesses");
+    RETURN_IF_SKIP(InitSyncVal());
+
+    vkt::Buffer buffer_src(*m_device, 1024, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+    vkt::Buffer buffer(*m_device, 1024, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+
+    VkMemoryBarrier mem_barrier = vku::InitStructHelper();
+    mem_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    mem_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+    m_command_buffer.Begin();
+    for (uint32_t i = 0; i < 100; ++i) {
+        // Each write overlaps two of the ranges written by the previous iterations
+        const VkDeviceSize offset = (i % 4) * 192;
+        VkBufferCopy region = {offset, offset, 256};
+        vk::CmdCopyBuffer(m_command_buffer, buffer_src, buffer, 1, &region);
+        vk::CmdPipelineBarrier(m_command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1,
+                               &mem_barrier, 0, nullptr, 0, nullptr);
+    }
+    m_command_buffer.End();
+
+    m_default_queue->Submit(m_command_buffer);
+    m_default_queue->Submit(m_command_buffer);
+    m_default_queue->Wait();
+}
+
 TEST_F(PositiveSyncVal, BufferCopySecondary) {
     TEST_DESCRIPTION("Execution dependency protects protects READ access from subsequent WRITEs");
     RETURN_IF_SKIP(InitSyncVal());
@@ -784,6 +821,77 @@ TEST_F(PositiveSyncVal, QSBufferCopyHazardsDisabled) {
     test.DeviceWait();
 }
 
+TEST_F(PositiveSyncVal, QSBoundedHistory) {
+    TEST_DESCRIPTION("Hazard against a submit that was dropped by the bounded history mode is not reported");
+    SyncValSettings settings;
+    settings.max_retained_submits = 1;
+    RETURN_IF_SKIP(InitSyncValFramework(&settings));
+    RETURN_IF_SKIP(InitState());
+
+    QSTestContext test(m_device, m_device->QueuesWithGraphicsCapability()[0]);
+    if (!test.Valid()) {
+        GTEST_SKIP() << "Test requires a valid queue object.";
+    }
+    const VkBufferUsageFlags transfer_usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    vkt::Buffer buffer_d(*m_device, 256, transfer_usage);
+    vkt::Buffer buffer_e(*m_device, 256, transfer_usage);
+
+    test.RecordCopy(test.cba, test.buffer_a, test.buffer_b);
+    test.RecordCopy(test.cbb, test.buffer_c, buffer_d);
+    test.RecordCopy(test.cbc, test.buffer_b, buffer_e);
+
+    test.Submit0(test.cba);
+    // Only the last submit is retained, so the write to buffer_b from the first submit is treated as completed
+    test.Submit0(test.cbb);
+    // This would be a READ_AFTER_WRITE hazard on buffer_b without the history limit
+    test.Submit0(test.cbc);
+
+    test.DeviceWait();
+}
+
+TEST_F(PositiveSyncVal, QSBoundedHistoryMemory) {
+    TEST_DESCRIPTION("Only the memory limit is set. Hazard against a submit that was dropped to fit the limit is not reported");
+    SyncValSettings settings;
+    settings.max_retained_history_mb = 1;
+    RETURN_IF_SKIP(InitSyncValFramework(&settings));
+    RETURN_IF_SKIP(InitState());
+
+    QSTestContext test(m_device, m_device->QueuesWithGraphicsCapability()[0]);
+    if (!test.Valid()) {
+        GTEST_SKIP() << "Test requires a valid queue object.";
+    }
+    // Every other byte is copied, so each region is tracked separately. That takes several megabytes of history.
+    constexpr uint32_t region_count = 4096;
+    const VkBufferUsageFlags transfer_usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    vkt::Buffer buffer_src(*m_device, 2 * region_count, transfer_usage);
+    vkt::Buffer buffer_dst(*m_device, 2 * region_count, transfer_usage);
+    vkt::Buffer buffer_d(*m_device, 256, transfer_usage);
+    vkt::Buffer buffer_e(*m_device, 256, transfer_usage);
+    std::vector<VkBufferCopy> sparse_regions(region_count);
+    for (uint32_t i = 0; i < region_count; ++i) {
+        sparse_regions[i] = {2 * i, 2 * i, 1};
+    }
+
+    test.cba.Begin();
+    vk::CmdCopyBuffer(test.cba, buffer_src, buffer_dst, region_count, sparse_regions.data());
+    test.cba.End();
+    test.RecordCopy(test.cbb, test.buffer_c, buffer_d);
+    test.RecordCopy(test.cbc, buffer_dst, buffer_e);
+
+    // Waited submits are released from the bounded history before the limit is reached
+    for (int i = 0; i < 8; ++i) {
+        test.Submit0(test.cbb);
+        test.DeviceWait();
+    }
+    test.Submit0(test.cba);
+    // The history is over the limit, so the first submit is treated as completed
+    test.Submit0(test.cbb);
+    // This would be a READ_AFTER_WRITE hazard on buffer_dst without the history limit
+    test.Submit0(test.cbc);
+
+    test.DeviceWait();
+}
+
 TEST_F(PositiveSyncVal, QSTransitionWithSrcNoneStage) {
     TEST_DESCRIPTION(
         "Two submission batches synchronized with binary semaphore. Layout transition in the second batch should not interfere "
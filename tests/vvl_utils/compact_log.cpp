@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "../framework/test_common.h"
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include "utils/compact_log.h"
+
+namespace {
+struct TestRecord {
+    uint32_t value = 0;  // delta encoded
+    uint32_t count = 0;  // plain varint
+    uint32_t run = 0;    // run key, not part of the encoded bytes
+
+    bool operator==(const TestRecord &other) const {
+        return value == other.value && count == other.count && run == other.run;
+    }
+};
+
+struct TestCodec {
+    using Record = TestRecord;
+    using RunKey = uint32_t;
+    struct State {
+        uint32_t value = 0;
+    };
+
+    static RunKey GetRunKey(const Record &record) { return record.run; }
+    static Record MakeRecord(const RunKey &run) {
+        Record record;
+        record.run = run;
+        return record;
+    }
+    static void EncodeRecord(const Record &record, State &state, std::vector<uint8_t> &bytes) {
+        vvl::EncodeVarint(vvl::EncodeDelta(record.value, state.value), bytes);
+        state.value = record.value;
+        vvl::EncodeVarint(record.count, bytes);
+    }
+    static void DecodeRecord(const uint8_t *&data, State &state, Record &record) {
+        record.value = state.value = vvl::DecodeDelta(static_cast<uint32_t>(vvl::DecodeVarint(data)), state.value);
+        record.count = static_cast<uint32_t>(vvl::DecodeVarint(data));
+    }
+};
+using TestLog = vvl::CompactLog<TestCodec>;
+
+constexpr uint32_t kBlockSize = TestLog::kBlockSize;
+
+// Values jump around, including across the unsigned wrap, and the run changes right before, on and after block edges
+std::vector<TestRecord> MakeRecords(uint32_t count) {
+    std::vector<TestRecord> records(count);
+    uint32_t run = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t in_block = i % kBlockSize;
+        if (in_block == 0 || in_block == kBlockSize - 1 || in_block == 1 || i % 7 == 0) {
+            ++run;
+        }
+        switch (i % 5) {
+            case 0:
+                records[i].value = i;
+                break;
+            case 1:
+                records[i].value = std::numeric_limits<uint32_t>::max() - i;
+                break;
+            case 2:
+                records[i].value = 0x80000000u + i;
+                break;
+            case 3:
+                records[i].value = records[i - 1].value;
+                break;
+            default:
+                records[i].value = records[i - 1].value - 1;
+                break;
+        }
+        records[i].count = (i % 3 == 0) ? 0x4000u * i : i;
+        records[i].run = run;
+    }
+    return records;
+}
+
+TestLog MakeLog(const std::vector<TestRecord> &records) {
+    std::vector<uint32_t> runs;
+    TestLog::Body body = TestLog::Encode(records, runs);
+    return TestLog(std::make_shared<const TestLog::Body>(std::move(body)), std::move(runs));
+}
+}  // namespace
+
+TEST(CompactLog, VarintRoundTrip) {
+    const uint64_t values[] = {0,      1,          0x7f,        0x80, 0x3fff,
+                               0x4000, 0xffffffff, 0x100000000, std::numeric_limits<uint64_t>::max()};
+    const size_t sizes[] = {1, 1, 1, 2, 2, 3, 5, 5, 10};
+
+    std::vector<uint8_t> bytes;
+    for (size_t i = 0; i < std::size(values); ++i) {
+        const size_t begin = bytes.size();
+        vvl::EncodeVarint(values[i], bytes);
+        ASSERT_EQ(bytes.size() - begin, sizes[i]) << "value " << values[i];
+    }
+    // Values decode back from the concatenated stream
+    const uint8_t *data = bytes.data();
+    for (uint64_t value : values) {
+        ASSERT_EQ(vvl::DecodeVarint(data), value);
+    }
+    ASSERT_EQ(data, bytes.data() + bytes.size());
+}
+
+TEST(CompactLog, DeltaRoundTrip) {
+    constexpr uint32_t kMax = std::numeric_limits<uint32_t>::max();
+    const uint32_t values[] = {0, 1, 2, 63, 64, 65, 0x7fffffff, 0x80000000, 0x80000001, kMax - 1, kMax};
+    for (uint32_t previous : values) {
+        for (uint32_t value : values) {
+            const uint32_t encoded = vvl::EncodeDelta(value, previous);
+            ASSERT_EQ(vvl::DecodeDelta(encoded, previous), value) << "value " << value << " previous " << previous;
+
+            // Deltas in [-64, 63] fit in a single varint byte
+            const int64_t delta = int64_t(int32_t(value - previous));
+            if (delta >= -64 && delta < 64) {
+                ASSERT_LT(encoded, 0x80u);
+            }
+        }
+    }
+    ASSERT_EQ(vvl::EncodeDelta(5, 5), 0u);
+    ASSERT_EQ(vvl::EncodeDelta(4, 5), 1u);
+    ASSERT_EQ(vvl::EncodeDelta(6, 5), 2u);
+    // Wrapping from the largest value to zero is a small positive delta
+    ASSERT_EQ(vvl::EncodeDelta(0, kMax), 2u);
+    ASSERT_EQ(vvl::EncodeDelta(kMax, 0), 1u);
+}
+
+TEST(CompactLog, EncodeDecode) {
+    for (uint32_t count : {1u, kBlockSize - 1, kBlockSize, kBlockSize + 1, 2 * kBlockSize, 2 * kBlockSize + 1, 100u}) {
+        const std::vector<TestRecord> records = MakeRecords(count);
+        const TestLog log = MakeLog(records);
+        ASSERT_EQ(log.Size(), count);
+        ASSERT_EQ(log.GetBody()->block_offsets.size(), (count + kBlockSize - 1) / kBlockSize);
+
+        // Backwards, so no record is decoded right after its predecessor
+        for (uint32_t i = count; i-- > 0;) {
+            ASSERT_EQ(log.Decode(i), records[i]) << "count " << count << " index " << i;
+        }
+    }
+}
+
+TEST(CompactLog, RunsAreNotEncoded) {
+    std::vector<TestRecord> records = MakeRecords(3 * kBlockSize);
+    // Logs with the same records and run layout have equal bodies, whatever their run keys
+    for (uint32_t i = 0; i < records.size(); ++i) {
+        records[i].run = 2000 + i;
+    }
+    const TestLog log_a = MakeLog(records);
+    for (uint32_t i = 0; i < records.size(); ++i) {
+        records[i].run = 3000 + i;
+    }
+    const TestLog log_b = MakeLog(records);
+    ASSERT_TRUE(*log_a.GetBody() == *log_b.GetBody());
+    ASSERT_EQ(log_a.GetBody()->hash, log_b.GetBody()->hash);
+    for (uint32_t i = 0; i < records.size(); ++i) {
+        ASSERT_EQ(log_a.Decode(i).run, 2000 + i);
+        ASSERT_EQ(log_b.Decode(i).run, 3000 + i);
+        ASSERT_EQ(log_a.Decode(i).value, log_b.Decode(i).value);
+    }
+}
+
+TEST(CompactLog, InternBodies) {
+    TestLog::BodyDictionary dictionary;
+    auto intern = [&dictionary](const std::vector<TestRecord> &records) {
+        std::vector<uint32_t> runs;
+        const TestLog::Body body = TestLog::Encode(records, runs);
+        return TestLog(dictionary.LookUp(body, body), std::move(runs));
+    };
+
+    std::vector<TestRecord> records = MakeRecords(kBlockSize + 1);
+    std::vector<TestRecord> rerecorded = records;
+    for (TestRecord &record : rerecorded) {
+        record.run += 100;
+    }
+    std::vector<TestRecord> changed = records;
+    changed.back().value += 1;
+
+    std::optional<TestLog> log = intern(records);
+    std::optional<TestLog> rerecorded_log = intern(rerecorded);
+    std::optional<TestLog> changed_log = intern(changed);
+    ASSERT_EQ(log->GetBody(), rerecorded_log->GetBody());
+    ASSERT_NE(log->GetBody(), changed_log->GetBody());
+    ASSERT_EQ(dictionary.Size(), 2u);
+
+    // A shared body decodes with the run keys of each log
+    for (uint32_t i = 0; i < records.size(); ++i) {
+        ASSERT_EQ(log->Decode(i), records[i]);
+        ASSERT_EQ(rerecorded_log->Decode(i), rerecorded[i]);
+        ASSERT_EQ(changed_log->Decode(i), changed[i]);
+    }
+
+    // A body is released with the last log using it
+    log.reset();
+    ASSERT_EQ(dictionary.Size(), 2u);
+    rerecorded_log.reset();
+    ASSERT_EQ(dictionary.Size(), 1u);
+    changed_log.reset();
+    ASSERT_EQ(dictionary.Size(), 0u);
+}
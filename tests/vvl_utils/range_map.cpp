@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "../framework/test_common.h"
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "containers/range_map.h"
+
+// The generic range_map algorithms are run against both a node based ImplMap (std::map, iterators stay valid on insert and
+// erase) and a B-tree (entries move between nodes), and compared against a flat array holding the value of every index.
+namespace {
+using Range = vvl::range<uint64_t>;
+using Model = std::vector<std::optional<int>>;
+
+constexpr uint64_t kIndexCount = 2048;
+
+template <typename Map>
+class RangeMapTest : public ::testing::Test {
+  protected:
+    RangeMapTest() : model_(kIndexCount), rng_(0x5eed) {}
+
+    Range RandomRange() {
+        const uint64_t begin = std::uniform_int_distribution<uint64_t>(0, kIndexCount - 1)(rng_);
+        const uint64_t length = std::uniform_int_distribution<uint64_t>(1, 48)(rng_);
+        return Range(begin, std::min(begin + length, kIndexCount));
+    }
+    // Few distinct values, so neighboring entries often have the same value and consolidate has something to merge
+    int RandomValue() { return std::uniform_int_distribution<int>(0, 3)(rng_); }
+
+    // Many small entries, so the B-tree has several levels
+    void Fill(Map &map, Model &model) {
+        for (uint32_t i = 0; i < 600; ++i) {
+            const Range range = RandomRange();
+            const int value = RandomValue();
+            map.overwrite_range(std::make_pair(range, value));
+            for (uint64_t index = range.begin; index < range.end; ++index) {
+                model[index] = value;
+            }
+        }
+    }
+
+    static void ExpectMatches(const Map &map, const Model &model) {
+        Model from_map(kIndexCount);
+        std::optional<uint64_t> last_end;
+        for (const auto &[range, value] : map) {
+            ASSERT_FALSE(range.empty());
+            ASSERT_LE(range.end, kIndexCount);
+            if (last_end) {
+                ASSERT_LE(*last_end, range.begin);
+            }
+            last_end = range.end;
+            for (uint64_t index = range.begin; index < range.end; ++index) {
+                from_map[index] = value;
+            }
+        }
+        for (uint64_t index = 0; index < kIndexCount; ++index) {
+            ASSERT_EQ(from_map[index], model[index]) << "index " << index;
+        }
+    }
+
+    Map map_;
+    Model model_;
+    std::mt19937 rng_;
+};
+
+struct AddOps {
+    template <typename Map>
+    void infill(Map &map, const typename Map::iterator &pos, const Range &range) const {
+        map.insert(pos, std::make_pair(range, infill_value));
+    }
+    template <typename Iterator>
+    void update(const Iterator &pos) const {
+        pos->second += 10;
+    }
+    int infill_value;
+};
+
+using RangeMapTypes =
+    ::testing::Types<sparse_container::range_map<uint64_t, int>, sparse_container::btree_range_map<uint64_t, int>>;
+}  // namespace
+
+TYPED_TEST_SUITE(RangeMapTest, RangeMapTypes);
+
+TYPED_TEST(RangeMapTest, OverwriteAndErase) {
+    this->Fill(this->map_, this->model_);
+    this->ExpectMatches(this->map_, this->model_);
+
+    for (uint32_t i = 0; i < 300; ++i) {
+        const Range range = this->RandomRange();
+        this->map_.erase_range(range);
+        for (uint64_t index = range.begin; index < range.end; ++index) {
+            this->model_[index].reset();
+        }
+    }
+    this->ExpectMatches(this->map_, this->model_);
+}
+
+TYPED_TEST(RangeMapTest, Split) {
+    this->Fill(this->map_, this->model_);
+    for (uint32_t i = 0; i < 300; ++i) {
+        const uint64_t index = std::uniform_int_distribution<uint64_t>(0, kIndexCount - 1)(this->rng_);
+        auto it = this->map_.find(index);
+        if (it != this->map_.end() && it->first.begin != index) {
+            // Keeping both halves returns the lower one
+            auto lower = this->map_.split(it, index, sparse_container::split_op_keep_both());
+            ASSERT_EQ(lower->first.end, index);
+            ++lower;
+            ASSERT_EQ(lower->first.begin, index);
+        }
+    }
+    this->ExpectMatches(this->map_, this->model_);
+}
+
+TYPED_TEST(RangeMapTest, InfillUpdateRange) {
+    this->Fill(this->map_, this->model_);
+    for (uint32_t i = 0; i < 300; ++i) {
+        const Range range = this->RandomRange();
+        const AddOps ops{this->RandomValue()};
+        sparse_container::infill_update_range(this->map_, range, ops);
+        for (uint64_t index = range.begin; index < range.end; ++index) {
+            auto &value = this->model_[index];
+            value = value ? *value + 10 : ops.infill_value;
+        }
+        this->ExpectMatches(this->map_, this->model_);
+    }
+}
+
+TYPED_TEST(RangeMapTest, UpdateRangeValue) {
+    this->Fill(this->map_, this->model_);
+    for (uint32_t i = 0; i < 300; ++i) {
+        const Range range = this->RandomRange();
+        const int value = this->RandomValue();
+        const auto precedence = (i % 2) ? sparse_container::value_precedence::prefer_source
+                                        : sparse_container::value_precedence::prefer_dest;
+        sparse_container::update_range_value(this->map_, range, value, precedence);
+        for (uint64_t index = range.begin; index < range.end; ++index) {
+            auto &model_value = this->model_[index];
+            if (!model_value || precedence == sparse_container::value_precedence::prefer_source) {
+                model_value = value;
+            }
+        }
+        this->ExpectMatches(this->map_, this->model_);
+    }
+}
+
+TYPED_TEST(RangeMapTest, Splice) {
+    this->Fill(this->map_, this->model_);
+    for (uint32_t i = 0; i < 20; ++i) {
+        TypeParam from;
+        Model from_model(kIndexCount);
+        // Sparse source, so both the infill and the update paths are taken
+        for (uint32_t j = 0; j < 40; ++j) {
+            const Range range = this->RandomRange();
+            const int value = this->RandomValue();
+            from.overwrite_range(std::make_pair(range, value));
+            for (uint64_t index = range.begin; index < range.end; ++index) {
+                from_model[index] = value;
+            }
+        }
+        const auto precedence = (i % 2) ? sparse_container::value_precedence::prefer_source
+                                        : sparse_container::value_precedence::prefer_dest;
+        sparse_container::splice(this->map_, from, precedence);
+        for (uint64_t index = 0; index < kIndexCount; ++index) {
+            auto &model_value = this->model_[index];
+            if (from_model[index] && (!model_value || precedence == sparse_container::value_precedence::prefer_source)) {
+                model_value = from_model[index];
+            }
+        }
+        this->ExpectMatches(this->map_, this->model_);
+    }
+}
+
+TYPED_TEST(RangeMapTest, Consolidate) {
+    this->Fill(this->map_, this->model_);
+    sparse_container::consolidate(this->map_);
+    this->ExpectMatches(this->map_, this->model_);
+
+    // Nothing left to merge
+    auto last = this->map_.end();
+    for (auto it = this->map_.begin(); it != this->map_.end(); ++it) {
+        if (last != this->map_.end()) {
+            ASSERT_FALSE(last->first.end == it->first.begin && last->second == it->second);
+        }
+        last = it;
+    }
+}
+
+TYPED_TEST(RangeMapTest, CachedLowerBound) {
+    this->Fill(this->map_, this->model_);
+    this->map_.erase_range(this->RandomRange());
+    this->model_.assign(kIndexCount, std::nullopt);
+    for (const auto &[range, value] : this->map_) {
+        for (uint64_t index = range.begin; index < range.end; ++index) {
+            this->model_[index] = value;
+        }
+    }
+
+    sparse_container::cached_lower_bound_impl<TypeParam> pos(this->map_, 0);
+    for (uint64_t index = 0; index < kIndexCount; ++index) {
+        pos.seek(index);
+        ASSERT_EQ(pos->valid, this->model_[index].has_value()) << "index " << index;
+        if (pos->valid) {
+            ASSERT_EQ(pos->lower_bound->second, *this->model_[index]) << "index " << index;
+        }
+    }
+}
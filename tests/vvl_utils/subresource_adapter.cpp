@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "../framework/test_common.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "containers/subresource_adapter.h"
+
+// ImageRangeGenerator output, stepped with operator++ and batched with Fill, is compared against the bytes of every texel
+// block row of the region, computed one row at a time from the encoder's subresource layouts. Abutting ranges are merged
+// before comparing, since the generator is free to return a contiguous span as one range or as many.
+namespace {
+using subresource_adapter::ImageRangeEncoder;
+using subresource_adapter::ImageRangeGenerator;
+using subresource_adapter::IndexRange;
+using subresource_adapter::IndexType;
+using RangeList = std::vector<IndexRange>;
+
+constexpr VkDeviceSize kBaseAddress = 0x10000;
+constexpr VkImageAspectFlags kColor = VK_IMAGE_ASPECT_COLOR_BIT;
+
+VkImageCreateInfo MakeCreateInfo(VkImageType type, VkFormat format, VkExtent3D extent, uint32_t mip_levels,
+                                 uint32_t array_layers) {
+    VkImageCreateInfo create_info = {};
+    create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    create_info.imageType = type;
+    create_info.format = format;
+    create_info.extent = extent;
+    create_info.mipLevels = mip_levels;
+    create_info.arrayLayers = array_layers;
+    create_info.samples = VK_SAMPLE_COUNT_1_BIT;
+    create_info.tiling = VK_IMAGE_TILING_OPTIMAL;
+    return create_info;
+}
+
+VkImageSubresourceRange MakeFullRange(const VkImageCreateInfo &create_info, VkImageAspectFlags aspect_mask) {
+    return {aspect_mask, 0, create_info.mipLevels, 0, create_info.arrayLayers};
+}
+
+// Generated ranges must be in increasing address order
+void AppendMerged(RangeList &list, const IndexRange &range) {
+    ASSERT_TRUE(range.non_empty());
+    if (!list.empty()) {
+        ASSERT_LE(list.back().end, range.begin);
+        if (list.back().end == range.begin) {
+            list.back().end = range.end;
+            return;
+        }
+    }
+    list.push_back(range);
+}
+
+RangeList Merge(const RangeList &ranges) {
+    RangeList merged;
+    for (const IndexRange &range : ranges) {
+        AppendMerged(merged, range);
+    }
+    return merged;
+}
+
+RangeList Step(ImageRangeGenerator gen) {
+    RangeList ranges;
+    for (; gen->non_empty(); ++gen) {
+        ranges.push_back(*gen);
+    }
+    return ranges;
+}
+
+RangeList FillAll(ImageRangeGenerator gen, uint32_t batch_size) {
+    RangeList ranges;
+    std::vector<IndexRange> batch(batch_size);
+    uint32_t count = 0;
+    do {
+        count = gen.Fill(batch.data(), batch_size);
+        ranges.insert(ranges.end(), batch.begin(), batch.begin() + count);
+    } while (count == batch_size);
+    return ranges;
+}
+
+// One range per texel block row of each layer (or depth slice) of each subresource in the region. A zero width extent
+// selects the whole extent of each mip level.
+RangeList Expected(const ImageRangeEncoder &encoder, const VkImageSubresourceRange &range, const VkOffset3D &region_offset,
+                   const VkExtent3D &region_extent) {
+    const VkExtent3D &block = encoder.TexelBlockExtent();
+    RangeList expected;
+    for (uint32_t aspect_index = 0; aspect_index < encoder.Limits().aspect_index; ++aspect_index) {
+        if ((encoder.AspectBit(aspect_index) & range.aspectMask) == 0) {
+            continue;
+        }
+        const double texel_size = encoder.TexelSize(aspect_index);
+        for (uint32_t mip = range.baseMipLevel; mip < range.baseMipLevel + range.levelCount; ++mip) {
+            const auto &info = encoder.GetSubresourceInfo(encoder.GetSubresourceIndex(aspect_index, mip));
+            const bool whole = region_extent.width == 0;
+            const VkOffset3D offset = whole ? VkOffset3D{0, 0, 0} : region_offset;
+            const VkExtent3D extent = whole ? info.extent : region_extent;
+
+            const uint32_t z_begin = encoder.Is3D() ? uint32_t(offset.z) : range.baseArrayLayer;
+            const uint32_t z_end = encoder.Is3D() ? z_begin + extent.depth : z_begin + range.layerCount;
+            const IndexType z_pitch = encoder.Is3D() ? info.layout.depthPitch : info.layout.arrayPitch;
+            const IndexType x_offset = static_cast<IndexType>(std::floor(offset.x * block.height * texel_size));
+            const IndexType row_size = static_cast<IndexType>(std::floor(extent.width * block.height * texel_size));
+            const uint32_t y_begin = uint32_t(offset.y);
+            for (uint32_t z = z_begin; z < z_end; z += encoder.Is3D() ? block.depth : 1) {
+                for (uint32_t y = y_begin; y < y_begin + extent.height; y += block.height) {
+                    const IndexType begin = kBaseAddress + info.layout.offset + z * z_pitch + y * info.layout.rowPitch + x_offset;
+                    expected.emplace_back(begin, begin + row_size);
+                }
+            }
+        }
+    }
+    return expected;
+}
+
+void CheckGenerator(const ImageRangeGenerator &gen, const RangeList &expected_rows) {
+    const RangeList stepped = Step(gen);
+    for (uint32_t batch_size : {1u, 2u, 3u, 7u, 64u}) {
+        const RangeList filled = FillAll(gen, batch_size);
+        ASSERT_EQ(filled.size(), stepped.size()) << "batch size " << batch_size;
+        for (size_t i = 0; i < stepped.size(); ++i) {
+            ASSERT_TRUE(filled[i] == stepped[i]) << "batch size " << batch_size << " range " << i;
+        }
+    }
+
+    const RangeList merged = Merge(stepped);
+    const RangeList expected = Merge(expected_rows);
+    ASSERT_EQ(merged.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(merged[i].begin, expected[i].begin) << "range " << i;
+        ASSERT_EQ(merged[i].end, expected[i].end) << "range " << i;
+    }
+}
+
+void CheckSubresources(const ImageRangeEncoder &encoder, const VkImageSubresourceRange &range) {
+    SCOPED_TRACE(testing::Message() << "mips " << range.baseMipLevel << "+" << range.levelCount << " layers "
+                                    << range.baseArrayLayer << "+" << range.layerCount);
+    const ImageRangeGenerator gen(encoder, range, kBaseAddress, false);
+    CheckGenerator(gen, Expected(encoder, range, {}, {}));
+}
+
+void CheckRegion(const ImageRangeEncoder &encoder, const VkImageSubresourceRange &range, const VkOffset3D &offset,
+                 const VkExtent3D &extent) {
+    SCOPED_TRACE(testing::Message() << "mip " << range.baseMipLevel << " layers " << range.baseArrayLayer << "+"
+                                    << range.layerCount << " offset " << offset.x << "," << offset.y << "," << offset.z
+                                    << " extent " << extent.width << "x" << extent.height << "x" << extent.depth);
+    const ImageRangeGenerator gen(encoder, range, offset, extent, kBaseAddress, false);
+    CheckGenerator(gen, Expected(encoder, range, offset, extent));
+}
+}  // namespace
+
+TEST(SubresourceAdapter, Image2D) {
+    const VkImageCreateInfo create_info = MakeCreateInfo(VK_IMAGE_TYPE_2D, VK_FORMAT_R8G8B8A8_UNORM, {64, 32, 1}, 4, 1);
+    const ImageRangeEncoder encoder(create_info, MakeFullRange(create_info, kColor));
+
+    CheckSubresources(encoder, MakeFullRange(create_info, kColor));
+    CheckSubresources(encoder, {kColor, 1, 2, 0, 1});
+    CheckSubresources(encoder, {kColor, 3, 1, 0, 1});
+
+    CheckRegion(encoder, {kColor, 0, 1, 0, 1}, {8, 4, 0}, {16, 8, 1});
+    CheckRegion(encoder, {kColor, 1, 1, 0, 1}, {0, 3, 0}, {32, 5, 1});
+    CheckRegion(encoder, {kColor, 2, 1, 0, 1}, {4, 0, 0}, {12, 8, 1});
+    CheckRegion(encoder, {kColor, 0, 1, 0, 1}, {0, 0, 0}, {64, 32, 1});
+}
+
+TEST(SubresourceAdapter, Image2DArray) {
+    const VkImageCreateInfo create_info = MakeCreateInfo(VK_IMAGE_TYPE_2D, VK_FORMAT_R8G8B8A8_UNORM, {32, 16, 1}, 3, 6);
+    const ImageRangeEncoder encoder(create_info, MakeFullRange(create_info, kColor));
+
+    CheckSubresources(encoder, MakeFullRange(create_info, kColor));
+    CheckSubresources(encoder, {kColor, 0, 3, 1, 3});
+    CheckSubresources(encoder, {kColor, 1, 1, 2, 4});
+
+    // Partial rows over several layers, every layer must produce all of its rows
+    CheckRegion(encoder, {kColor, 0, 1, 1, 4}, {4, 2, 0}, {8, 5, 1});
+    CheckRegion(encoder, {kColor, 2, 1, 0, 6}, {1, 1, 0}, {2, 3, 1});
+    CheckRegion(encoder, {kColor, 1, 1, 0, 6}, {0, 1, 0}, {16, 6, 1});
+    CheckRegion(encoder, {kColor, 0, 1, 2, 2}, {0, 0, 0}, {32, 16, 1});
+}
+
+TEST(SubresourceAdapter, Image3D) {
+    const VkImageCreateInfo create_info = MakeCreateInfo(VK_IMAGE_TYPE_3D, VK_FORMAT_R8G8B8A8_UNORM, {16, 16, 8}, 3, 1);
+    const ImageRangeEncoder encoder(create_info, MakeFullRange(create_info, kColor));
+
+    CheckSubresources(encoder, MakeFullRange(create_info, kColor));
+    CheckSubresources(encoder, {kColor, 1, 1, 0, 1});
+
+    // Partial rows over several depth slices
+    CheckRegion(encoder, {kColor, 0, 1, 0, 1}, {2, 3, 1}, {8, 4, 5});
+    CheckRegion(encoder, {kColor, 1, 1, 0, 1}, {0, 2, 0}, {8, 3, 4});
+    CheckRegion(encoder, {kColor, 0, 1, 0, 1}, {0, 0, 2}, {16, 16, 3});
+
+    // Depth slices addressed as layers of a 2D compatible view
+    const ImageRangeGenerator sliced(encoder, {kColor, 0, 1, 2, 3}, kBaseAddress, true);
+    CheckGenerator(sliced, Expected(encoder, {kColor, 0, 1, 0, 1}, {0, 0, 2}, {16, 16, 3}));
+}
+
+TEST(SubresourceAdapter, CompressedImage) {
+    // 4x4 texel blocks of 8 bytes
+    const VkImageCreateInfo create_info = MakeCreateInfo(VK_IMAGE_TYPE_2D, VK_FORMAT_BC1_RGB_UNORM_BLOCK, {64, 64, 1}, 3, 4);
+    const ImageRangeEncoder encoder(create_info, MakeFullRange(create_info, kColor));
+    ASSERT_TRUE(encoder.IsCompressed());
+
+    CheckSubresources(encoder, MakeFullRange(create_info, kColor));
+    CheckSubresources(encoder, {kColor, 1, 1, 1, 2});
+
+    CheckRegion(encoder, {kColor, 0, 1, 1, 3}, {8, 4, 0}, {16, 12, 1});
+    CheckRegion(encoder, {kColor, 1, 1, 0, 4}, {0, 8, 0}, {32, 16, 1});
+    CheckRegion(encoder, {kColor, 2, 1, 2, 1}, {4, 4, 0}, {12, 12, 1});
+}
+
+TEST(SubresourceAdapter, DepthStencilImage) {
+    constexpr VkImageAspectFlags kDepth = VK_IMAGE_ASPECT_DEPTH_BIT;
+    constexpr VkImageAspectFlags kStencil = VK_IMAGE_ASPECT_STENCIL_BIT;
+    constexpr VkImageAspectFlags kDepthStencil = kDepth | kStencil;
+    const VkImageCreateInfo create_info = MakeCreateInfo(VK_IMAGE_TYPE_2D, VK_FORMAT_D32_SFLOAT_S8_UINT, {16, 8, 1}, 2, 3);
+    const ImageRangeEncoder encoder(create_info, MakeFullRange(create_info, kDepthStencil));
+
+    CheckSubresources(encoder, MakeFullRange(create_info, kDepthStencil));
+    CheckSubresources(encoder, {kDepthStencil, 1, 1, 1, 2});
+    CheckSubresources(encoder, {kStencil, 0, 2, 0, 3});
+
+    CheckRegion(encoder, {kDepthStencil, 0, 1, 0, 3}, {2, 1, 0}, {4, 5, 1});
+    CheckRegion(encoder, {kDepth, 1, 1, 1, 2}, {0, 1, 0}, {8, 2, 1});
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025 The Khronos Group Inc.
+ * Copyright (c) 2025 Valve Corporation
+ * Copyright (c) 2025 LunarG, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ */
+
+#include "../framework/test_common.h"
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "utils/hash_util.h"
+
+namespace {
+struct StringHash {
+    size_t operator()(std::string_view value) const { return std::hash<std::string_view>()(value); }
+};
+struct StringEqual {
+    bool operator()(std::string_view lhs, std::string_view rhs) const { return lhs == rhs; }
+};
+using StringDict = hash_util::WeakDictionary<std::string, StringHash, StringEqual>;
+}  // namespace
+
+TEST(WeakDictionary, SharesEqualValues) {
+    StringDict dict;
+    const char *text = "color blend";
+    StringDict::Id a = dict.LookUp(std::string_view(text), text);
+    StringDict::Id b = dict.LookUp(std::string_view("color blend"), "color blend");
+    StringDict::Id c = dict.LookUp(std::string_view("depth stencil"), "depth stencil");
+    ASSERT_EQ(a, b);
+    ASSERT_NE(a, c);
+    ASSERT_EQ(*a, "color blend");
+    ASSERT_EQ(*c, "depth stencil");
+    ASSERT_EQ(dict.Size(), 2u);
+}
+
+TEST(WeakDictionary, ReleasesUnusedEntries) {
+    StringDict dict;
+    StringDict::Id a = dict.LookUp(std::string_view("multisample"), "multisample");
+    StringDict::Id b = a;
+    a.reset();
+    ASSERT_EQ(dict.Size(), 1u);
+    b.reset();
+    ASSERT_EQ(dict.Size(), 0u);
+
+    // A released value is added again on the next look up
+    StringDict::Id c = dict.LookUp(std::string_view("multisample"), "multisample");
+    ASSERT_EQ(*c, "multisample");
+    ASSERT_EQ(dict.Size(), 1u);
+}
+
+TEST(WeakDictionary, IdOutlivesDictionary) {
+    StringDict::Id id;
+    {
+        StringDict dict;
+        id = dict.LookUp(std::string_view("rasterization"), "rasterization");
+    }
+    ASSERT_EQ(*id, "rasterization");
+}
+
+TEST(WeakDictionary, ConcurrentLookUp) {
+    StringDict dict;
+    constexpr uint32_t kThreads = 8;
+    constexpr uint32_t kIterations = 1000;
+    std::vector<std::vector<StringDict::Id>> ids(kThreads);
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&dict, &ids, t]() {
+            for (uint32_t i = 0; i < kIterations; ++i) {
+                const std::string value = std::to_string(i % 16);
+                StringDict::Id id = dict.LookUp(std::string_view(value), value);
+                // Drop every other Id so entries are released and added again while other threads look them up
+                if (i % 2 == 0) {
+                    ids[t].emplace_back(std::move(id));
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (uint32_t t = 1; t < kThreads; ++t) {
+        for (uint32_t i = 0; i < ids[t].size(); ++i) {
+            ASSERT_EQ(*ids[t][i], *ids[0][i]);
+        }
+    }
+    ASSERT_EQ(dict.Size(), 8u);
+    ids.clear();
+    ASSERT_EQ(dict.Size(), 0u);
+}